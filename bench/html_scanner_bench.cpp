@@ -0,0 +1,153 @@
+// Compares field extraction from a steamdb.info-like app page with the std::regex set the
+// scraper used to build per call against the precompiled HtmlScanner patterns.
+// Build with -DSTEAMDB_BUILD_BENCHMARKS=ON and run ./html_scanner_bench [iterations].
+#include "html_scanner.h"
+#include "steamdb_patterns.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+struct Fields
+{
+    std::string appId, name, releaseDate, currentPrice, lowestPrice, metacritic, reviewScore;
+    std::vector<std::string> tags;
+
+    bool operator==(const Fields &other) const
+    {
+        return appId == other.appId && name == other.name && releaseDate == other.releaseDate &&
+               currentPrice == other.currentPrice && lowestPrice == other.lowestPrice &&
+               metacritic == other.metacritic && reviewScore == other.reviewScore && tags == other.tags;
+    }
+};
+
+// Roughly the shape of a search result row followed by an app page, padded with markup.
+// A data-appid outside any row comes first; like the regex, the scanner must skip it.
+static std::string buildPage(size_t fillerRows)
+{
+    std::string filler;
+    for (size_t i = 0; i < fillerRows; ++i)
+    {
+        filler += "<tr class=\"row\"><td class=\"a\">Key " + std::to_string(i) + "</td><td>value</td></tr>\n";
+    }
+    std::string page = "<html><body><div class=\"card\" data-appid=\"730\">Counter-Strike 2</div><table>" + filler;
+    page += "<tr class=\"app\" data-appid=\"292030\"> <td>Game</td> <td><a href=\"/app/292030/\">The Witcher 3</a></td> "
+            "<td>18 May 2015</td></tr>\n";
+    page += filler;
+    page += "<tr><td class=\"k\">Current Price:</td> <td class=\"v\">$39.99</td></tr>\n"
+            "<tr><td>Lowest Price:</td> <td>$5.99</td></tr>\n"
+            "<tr><td>Metacritic Score:</td> <td><a href=\"/mc\">93</a></td></tr>\n"
+            "<tr><td>User Reviews:</td> <td>97.1%</td></tr>\n";
+    for (int i = 0; i < 20; ++i)
+    {
+        page += "<a class=\"app-tag\" href=\"/tag/" + std::to_string(i) + "\">Tag " + std::to_string(i) + "</a>\n";
+    }
+    page += filler + "</table></body></html>";
+    return page;
+}
+
+static Fields extractWithRegex(const std::string &html)
+{
+    Fields fields;
+    std::regex tableRowRegex("<tr[^>]*data-appid=\"(\\d+)\"[^>]*>\\s*"
+                             "<td[^>]*>.*?</td>\\s*"
+                             "<td[^>]*><a[^>]*>(.*?)</a>.*?</td>\\s*"
+                             "<td[^>]*>(.*?)</td>");
+    std::smatch match;
+    if (std::regex_search(html, match, tableRowRegex))
+    {
+        fields.appId = match[1].str();
+        fields.name = match[2].str();
+        fields.releaseDate = match[3].str();
+    }
+    std::regex priceRegex("<td[^>]*>Current Price:</td>\\s*<td[^>]*>(.*?)</td>");
+    if (std::regex_search(html, match, priceRegex))
+        fields.currentPrice = match[1].str();
+    std::regex lowestPriceRegex("<td[^>]*>Lowest Price:</td>\\s*<td[^>]*>(.*?)</td>");
+    if (std::regex_search(html, match, lowestPriceRegex))
+        fields.lowestPrice = match[1].str();
+    std::regex metacriticRegex("Metacritic Score:</td>\\s*<td[^>]*><a[^>]*>(\\d+)</a>");
+    if (std::regex_search(html, match, metacriticRegex))
+        fields.metacritic = match[1].str();
+    std::regex tagsRegex("<a[^>]*class=\"app-tag\"[^>]*>(.*?)</a>");
+    for (auto start = html.cbegin(); std::regex_search(start, html.cend(), match, tagsRegex); start = match.suffix().first)
+        fields.tags.push_back(match[1].str());
+    std::regex reviewRegex("User Reviews:</td>\\s*<td[^>]*>(.*?)</td>");
+    if (std::regex_search(html, match, reviewRegex))
+        fields.reviewScore = match[1].str();
+    return fields;
+}
+
+static std::string first(const HtmlScanner::Pattern &pattern, const std::string &html, size_t index = 0)
+{
+    HtmlScanner::Matcher matcher(pattern);
+    std::vector<std::string_view> captures;
+    return matcher.next(html, captures) ? std::string(captures[index]) : std::string();
+}
+
+static Fields extractWithScanner(const std::string &html)
+{
+    Fields fields;
+    HtmlScanner::Matcher row(SteamdbPatterns::RESULT_ROW);
+    std::vector<std::string_view> captures;
+    if (row.next(html, captures))
+    {
+        fields.appId = std::string(captures[0]);
+        fields.name = std::string(captures[1]);
+        fields.releaseDate = std::string(captures[2]);
+    }
+    fields.currentPrice = first(SteamdbPatterns::CURRENT_PRICE, html);
+    fields.lowestPrice = first(SteamdbPatterns::LOWEST_PRICE, html);
+    fields.reviewScore = first(SteamdbPatterns::USER_REVIEWS, html);
+    HtmlScanner::Matcher metacritic(SteamdbPatterns::METACRITIC);
+    while (metacritic.next(html, captures))
+    {
+        if (SteamdbPatterns::isScore(captures[0]))
+        {
+            fields.metacritic = std::string(captures[0]);
+            break;
+        }
+    }
+    HtmlScanner::Matcher tag(SteamdbPatterns::APP_TAG);
+    while (tag.next(html, captures))
+    {
+        fields.tags.push_back(std::string(captures[0]));
+    }
+    return fields;
+}
+
+template <typename Extract>
+static double secondsFor(Extract extract, const std::string &page, int iterations, Fields &fields)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        fields = extract(page);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 20;
+    std::string page = buildPage(500);
+
+    Fields fromRegex;
+    Fields fromScanner;
+    double regexSeconds = secondsFor(extractWithRegex, page, iterations, fromRegex);
+    double scannerSeconds = secondsFor(extractWithScanner, page, iterations, fromScanner);
+    if (!(fromRegex == fromScanner))
+    {
+        std::cerr << "Extracted fields differ between std::regex and HtmlScanner" << std::endl;
+        return 1;
+    }
+
+    double megabytes = page.size() * double(iterations) / (1024 * 1024);
+    std::cout << "Page: " << page.size() / 1024 << " KB, " << iterations << " iterations" << std::endl;
+    std::cout << "std::regex:  " << regexSeconds * 1000 / iterations << " ms/page, " << megabytes / regexSeconds << " MB/s" << std::endl;
+    std::cout << "HtmlScanner: " << scannerSeconds * 1000 / iterations << " ms/page, " << megabytes / scannerSeconds << " MB/s" << std::endl;
+    std::cout << "Speedup: " << regexSeconds / scannerSeconds << "x" << std::endl;
+    return 0;
+}
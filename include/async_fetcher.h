@@ -0,0 +1,76 @@
+#pragma once
+#include "connection_pool.h"
+#include "network_utils.h"
+#include <string>
+#include <future>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <optional>
+#include <functional>
+
+// Concurrent HTTP engine built on curl_multi.
+// Requests are queued from any thread and driven by one background thread,
+// so many transfers can be in flight at once; results are delivered through futures.
+class AsyncFetcher
+{
+public:
+    // Response body shared by every caller waiting on the same fetch
+    using Body = std::shared_ptr<const std::string>;
+
+    // Get the shared fetcher instance (starts the worker thread on first use)
+    static AsyncFetcher &getInstance();
+
+    // Queue a GET request; the future yields the body or throws NetworkError / HttpError.
+    // Failures are retried with the same policy as NetworkUtils::fetchPageWithRetry.
+    // onDone runs on the worker thread right after the future is resolved.
+    std::shared_future<Body> fetch(const std::string &url, int maxRetries = 3, int retryDelay = 2000,
+                                   std::function<void()> onDone = nullptr);
+
+private:
+    struct Request
+    {
+        std::string url;
+        NetworkUtils::HttpResponse response;
+        std::promise<Body> promise;
+        std::function<void()> onDone;
+        std::optional<ConnectionPool::Handle> handle;
+        int attempt;
+        int maxRetries;
+        int retryDelay;
+        std::chrono::steady_clock::time_point startAt;
+        uint64_t traceId; // Groups the request's spans on one track when tracing
+        std::chrono::steady_clock::time_point queuedAt;
+        std::chrono::steady_clock::time_point transferStartedAt;
+    };
+
+    AsyncFetcher();
+    ~AsyncFetcher();
+    AsyncFetcher(const AsyncFetcher &) = delete;
+    AsyncFetcher &operator=(const AsyncFetcher &) = delete;
+
+    // Worker loop driving the multi handle
+    void run();
+
+    // Move due requests from the queue onto the multi handle
+    void startDueRequests(std::chrono::steady_clock::time_point now);
+
+    // Handle a finished transfer: resolve, retry or fail it
+    void finishRequest(CURL *curl, CURLcode result);
+
+    // Resolve a request's future with its body, or with the error if one is given
+    static void settle(Request &request, std::exception_ptr error);
+
+    // Milliseconds until the next queued request becomes due
+    int nextWakeupMs(std::chrono::steady_clock::time_point now);
+
+    CURLM *multi;
+    std::thread worker;
+    std::mutex queueMutex;
+    std::deque<std::unique_ptr<Request>> pending;
+    std::vector<Request *> inFlight;
+    bool stopping;
+};
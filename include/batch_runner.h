@@ -0,0 +1,97 @@
+#pragma once
+#include "game_data.h"
+#include "game_cache.h"
+#include "scraper.h"
+#include "steam_api_helper.h"
+#include <string>
+#include <istream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+// Outcome of resolving one batch input line
+struct BatchResult
+{
+    enum class Status
+    {
+        Found,
+        NotFound,
+        Failed
+    };
+
+    size_t index = 0; // Position of the line in the input, starting at 0
+    std::string input;
+    Status status = Status::NotFound;
+    std::string error;         // Failure message when status is Failed
+    bool fromSteamApi = false; // steamInfo holds the result, otherwise gameData
+    SteamGameInfo steamInfo{};
+    GameData gameData;
+};
+
+// Totals reported at the end of a batch run
+struct BatchSummary
+{
+    size_t total = 0;
+    size_t found = 0;
+    size_t notFound = 0;
+    size_t failed = 0;
+    double seconds = 0.0;
+};
+
+// Resolves a stream of game names or App IDs (one per line) on a pool of worker threads.
+// Workers pull lines straight from the input, so long lists start producing results
+// immediately; all requests go through the shared per-host rate limiter. Results are
+// handed to the callback one at a time, either in input order or as they complete.
+class BatchRunner
+{
+public:
+    using ResultCallback = std::function<void(const BatchResult &)>;
+    using PriceCallback = std::function<void(const std::string &input, const SteamSaleInfo &sale)>;
+
+    BatchRunner(SteamApiHelper &steamApi, bool steamApiAvailable, GameCache &gameCache, Scraper &scraper);
+
+    // Resolve every non-empty line of the input with the given number of workers
+    BatchSummary run(std::istream &input, int workers, bool ordered, const ResultCallback &onResult);
+
+    // Resolve a single game name or App ID
+    BatchResult resolve(const std::string &input);
+
+    // Prices-only mode: map each line to an App ID and fetch just its price_overview, many apps
+    // per request on the calling thread. Results arrive in input order; unresolved lines get a sale
+    // with an empty name, and lines whose request failed get one with the error set.
+    BatchSummary runPrices(std::istream &input, const PriceCallback &onPrice);
+
+private:
+    // Worker loop: read a line, resolve it, publish the result
+    void work(std::istream &input);
+
+    // Read the next non-empty line and assign it an index; false at end of input
+    bool nextLine(std::istream &input, std::string &line, size_t &index);
+
+    // Hand a result to the callback, holding it back until its turn in ordered mode
+    void publish(BatchResult result);
+
+    // Results allowed to wait for a slow predecessor before workers pause
+    static const size_t MAX_REORDER = 1024;
+
+    // Lines priced per round in prices-only mode (several batched requests in flight)
+    static const size_t PRICE_CHUNK = 10 * SteamApiHelper::APPDETAILS_BATCH_SIZE;
+
+    SteamApiHelper &steamApi;
+    bool steamApiAvailable;
+    GameCache &gameCache;
+    Scraper &scraper;
+
+    std::mutex inputMutex;
+    size_t nextIndex = 0;
+
+    std::mutex outputMutex;
+    std::condition_variable outputReady;
+    std::map<size_t, BatchResult> reorderBuffer;
+    size_t nextToEmit = 0;
+    bool ordered = true;
+    const ResultCallback *callback = nullptr;
+    BatchSummary summary;
+};
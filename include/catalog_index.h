@@ -0,0 +1,90 @@
+#pragma once
+#include "mapped_file.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+// Local index of the full Steam app catalog for name -> app ID resolution.
+// The app list is downloaded once, written as a compact sorted file and memory-mapped,
+// so lookups are binary searches over the mapping without any network round trip.
+//
+// File layout (native byte order):
+//   header: "SDBA" | u32 version | i64 built-at (unix seconds) | u32 app count | u32 blob size
+//   entries (sorted by normalized name, then app ID):
+//           u32 app ID | u32 key offset | u32 key length | u32 name offset | u32 name length
+//   blob:   normalized keys and display names referenced by the entries
+class CatalogIndex
+{
+public:
+    struct App
+    {
+        uint32_t appId;
+        std::string_view name;
+    };
+
+    // Get the shared catalog instance
+    static CatalogIndex &getInstance();
+
+    // Map the catalog file, downloading a fresh app list when it is missing or older than maxAgeHours
+    bool load(const std::string &path, int maxAgeHours);
+
+    // Check if a catalog is mapped
+    bool isLoaded() const;
+
+    // Number of apps in the catalog
+    size_t size() const;
+
+    // Get the app at a position in name order
+    App at(size_t index) const;
+
+    // Find apps whose normalized name equals the normalized query
+    std::vector<App> findExact(const std::string &name, size_t limit) const;
+
+    // Display name of an app ID, or empty if the catalog does not list it
+    std::string_view findName(uint32_t appId) const;
+
+    // Lowercase a name and collapse punctuation and whitespace runs into single spaces
+    static std::string normalize(std::string_view name);
+
+    // Download the full app list and atomically write a catalog file
+    static bool download(const std::string &path);
+
+private:
+    struct Entry
+    {
+        uint32_t appId;
+        uint32_t keyOffset;
+        uint32_t keyLength;
+        uint32_t nameOffset;
+        uint32_t nameLength;
+    };
+
+    CatalogIndex();
+    CatalogIndex(const CatalogIndex &) = delete;
+    CatalogIndex &operator=(const CatalogIndex &) = delete;
+
+    // Validate the mapped header and locate the entry table and blob
+    bool attach();
+
+    Entry entryAt(size_t index) const;
+    std::string_view keyAt(size_t index) const;
+
+    // First entry whose key is not less than the given key
+    size_t lowerBound(std::string_view key) const;
+
+    static const uint32_t FILE_VERSION = 1;
+    static const size_t HEADER_SIZE = 24;
+
+    MappedFile mappedFile;
+    const char *entries;
+    const char *blob;
+    size_t count;
+    int64_t builtAt;
+
+    // (app ID << 32 | entry index) sorted for reverse lookups, built on first use
+    mutable std::mutex byIdMutex;
+    mutable std::vector<uint64_t> byId;
+};
@@ -25,6 +25,13 @@ public:
     // Parse command-line arguments for options and game names
     static void parseArguments(int argc, char *argv[], std::string &gameName, std::vector<std::string> &options);
 
+    // Check if an option was given, either bare ("--batch") or with a value ("--batch=FILE")
+    static bool hasOption(const std::vector<std::string> &options, const std::string &name);
+
+    // Get the value of a "--name=value" option, or the default when absent or bare
+    static std::string getOptionValue(const std::vector<std::string> &options, const std::string &name,
+                                      const std::string &defaultValue = "");
+
     // Display help message and usage information
     static void displayHelpMessage();
 
@@ -13,6 +13,9 @@ public:
     // Get a configuration value by key
     std::string get(const std::string &key) const;
 
+    // Get an integer value, or the default when the key is missing or not a number
+    long long getInt(const std::string &key, long long defaultValue) const;
+
     // Set a configuration value by key
     void set(const std::string &key, const std::string &value);
 
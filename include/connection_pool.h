@@ -0,0 +1,65 @@
+#pragma once
+#include <curl/curl.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+// Process-wide pool of keep-alive CURL easy handles.
+// Idle handles are kept per host so their live connections get reused, and every
+// handle is attached to one CURLSH object sharing the DNS cache and TLS sessions.
+class ConnectionPool
+{
+public:
+    // RAII lease on a pooled handle; the handle goes back to the pool on destruction
+    class Handle
+    {
+    public:
+        Handle(ConnectionPool *pool, std::string host, CURL *curl);
+        Handle(Handle &&other) noexcept;
+        Handle(const Handle &) = delete;
+        Handle &operator=(const Handle &) = delete;
+        Handle &operator=(Handle &&) = delete;
+        ~Handle();
+
+        // Get the underlying CURL handle
+        CURL *get() const { return curl; }
+
+    private:
+        ConnectionPool *pool;
+        std::string host;
+        CURL *curl;
+    };
+
+    // Get the shared pool instance (performs curl_global_init on first use)
+    static ConnectionPool &getInstance();
+
+    // Lease a configured handle for the host of the given URL
+    Handle acquire(const std::string &url);
+
+    // Extract the host component of a URL
+    static std::string hostFromUrl(const std::string &url);
+
+private:
+    ConnectionPool();
+    ~ConnectionPool();
+    ConnectionPool(const ConnectionPool &) = delete;
+    ConnectionPool &operator=(const ConnectionPool &) = delete;
+
+    // Return a handle to the idle list of its host
+    void release(const std::string &host, CURL *curl);
+
+    // Apply the options every pooled handle needs
+    void configureHandle(CURL *curl);
+
+    // Share object locking callbacks
+    static void lockShare(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr);
+    static void unlockShare(CURL *handle, curl_lock_data data, void *userptr);
+
+    static const size_t MAX_IDLE_PER_HOST = 8;
+
+    CURLSH *share;
+    std::mutex shareLocks[CURL_LOCK_DATA_LAST];
+    std::mutex poolMutex;
+    std::unordered_map<std::string, std::vector<CURL *>> idleHandles;
+};
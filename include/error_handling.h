@@ -2,6 +2,7 @@
 #include <stdexcept>
 #include <iostream>
 #include <exception>
+#include <chrono>
 
 // Custom exception class for parsing errors
 class ParsingError : public std::runtime_error {
@@ -21,5 +22,22 @@ public:
     explicit NetworkError(const std::string& message) : std::runtime_error(message) {}
 };
 
+// Network error for a response with an HTTP error status (4xx/5xx)
+class HttpError : public NetworkError {
+public:
+    HttpError(long status, std::chrono::seconds retryAfter, const std::string& message)
+        : NetworkError(message), statusCode(status), retryAfterDelay(retryAfter) {}
+
+    // HTTP status code of the response
+    long status() const { return statusCode; }
+
+    // Delay requested by the server's Retry-After header (zero if absent)
+    std::chrono::seconds retryAfter() const { return retryAfterDelay; }
+
+private:
+    long statusCode;
+    std::chrono::seconds retryAfterDelay;
+};
+
 // Declare the global error handler function as an external function
 extern void globalErrorHandler();
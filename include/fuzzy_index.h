@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Inverted trigram index for typo-tolerant game name lookup.
+// Names are reduced to lowercase letters and digits ("The Witcher 3" -> "thewitcher3"),
+// so spacing and punctuation differences ("witcher3", "cyberpnk") still share most
+// trigrams with the intended title. Matches are ranked by trigram overlap.
+class FuzzyIndex
+{
+public:
+    struct Match
+    {
+        uint32_t appId;
+        std::string_view name;
+        double score;
+    };
+
+    // Add a name; the referenced characters must outlive the index
+    void add(uint32_t appId, std::string_view name);
+
+    // Build the posting lists once every name has been added
+    void build();
+
+    // Number of indexed names
+    size_t size() const;
+
+    // Return the best-scoring matches for a query, highest score first
+    std::vector<Match> search(const std::string &query, size_t limit) const;
+
+private:
+    struct Document
+    {
+        uint32_t appId;
+        std::string_view name;
+        uint16_t gramCount;
+    };
+
+    // Extract the sorted, unique trigrams of a name
+    static void extractGrams(std::string_view name, std::vector<uint32_t> &grams);
+
+    std::vector<Document> documents;
+    std::vector<uint64_t> pairs;     // (gram << 32 | document) while building
+    std::vector<uint32_t> grams;     // Sorted distinct trigrams
+    std::vector<uint32_t> offsets;   // Posting list start per gram, plus an end sentinel
+    std::vector<uint32_t> postings;  // Document IDs grouped by gram
+};
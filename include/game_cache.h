@@ -1,24 +1,88 @@
 #pragma once
 #include "game_data.h"
 #include <unordered_map>
+#include <list>
 #include <string>
-#include <mutex>
+#include <memory>
+#include <shared_mutex>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 
+// Concurrent in-memory cache of scraped game data bounded by an approximate byte budget.
+// Keys are spread over independently locked shards. Lookups take only a shared lock and
+// hand out immutable snapshots, so readers never copy game data or block each other.
+// Eviction is CLOCK (second chance), an LRU approximation that lets a hit mark an entry
+// as recently used with a relaxed atomic store instead of relinking it under a write lock.
 class GameCache {
 public:
+    // Counters describing cache effectiveness and footprint
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+        size_t maxBytes = 0;
+    };
+
+    // Default memory budget when CACHE_MEMORY_LIMIT_MB is not configured
+    static const size_t DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+
+    // Create a cache holding at most maxBytes of game data
+    explicit GameCache(size_t maxBytes = DEFAULT_MAX_BYTES);
+
     // Check if the cache contains data for the given game
     bool hasGame(const std::string& gameName);
 
-    // Add game data to the cache
+    // Add game data to the cache, evicting cold entries to stay in budget
     void addGame(const std::string& gameName, const GameData& data);
 
-    // Retrieve game data from the cache
-    GameData getGame(const std::string& gameName);
+    // Retrieve a shared snapshot of the game data, or nullptr if it is not cached
+    std::shared_ptr<const GameData> getGame(const std::string& gameName);
+
+    // Change the memory budget, evicting entries if it shrank
+    void setMaxBytes(size_t maxBytes);
+
+    // Get the hit, miss and eviction counters
+    Stats getStats();
 
     // Clear the cache
     void clear();
 
 private:
-    std::unordered_map<std::string, GameData> cache;
-    std::mutex cacheMutex;
+    static const size_t SHARD_COUNT = 16;
+
+    struct Node {
+        Node(const std::string& name, std::shared_ptr<const GameData> data, size_t bytes)
+            : name(name), data(std::move(data)), bytes(bytes), referenced(false) {}
+
+        std::string name;
+        std::shared_ptr<const GameData> data;
+        size_t bytes;
+        std::atomic<bool> referenced; // Set by readers, cleared by the clock hand
+    };
+
+    // Padded so neighbouring shards' counters do not share a cache line
+    struct alignas(64) Shard {
+        std::shared_mutex mutex;
+        std::list<Node> clock; // Clock hand at the front
+        std::unordered_map<std::string, std::list<Node>::iterator> index;
+        size_t bytes = 0;
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> evictions{0};
+    };
+
+    // Approximate heap plus bookkeeping footprint of one entry
+    static size_t estimateSize(const std::string& gameName, const GameData& data);
+
+    // Pick the shard owning a key
+    Shard& shardFor(const std::string& gameName);
+
+    // Evict cold entries until the shard fits its budget (caller holds the write lock)
+    void evictToBudget(Shard& shard, size_t budget);
+
+    Shard shards[SHARD_COUNT];
+    std::atomic<size_t> maxBytes;
 };
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Literal-anchored HTML field extraction, used instead of std::regex for steamdb.info pages.
+// A pattern is a fixed sequence of "skip past literal" and "capture up to literal" steps,
+// each optionally confined to the text before a bound (such as the ">" closing a tag or
+// the "</tr>" closing a row), compiled once; searching for each literal compares its first and last bytes across
+// 16-byte blocks (SSE2 where available, memchr otherwise) before verifying candidates.
+namespace HtmlScanner
+{
+    // Precompiled literal to search for
+    class Literal
+    {
+    public:
+        Literal(std::string_view text);
+
+        // Offset of the first occurrence at or after `from`, or npos
+        size_t findIn(std::string_view text, size_t from = 0) const;
+
+        size_t size() const { return text.size(); }
+
+    private:
+        std::string text;
+    };
+
+    // One step of a pattern: skip past a literal, or capture the text up to it. With a bound,
+    // the literal must occur before the next occurrence of the bound or the anchor is rejected.
+    struct Step
+    {
+        bool capture;
+        std::string_view literal;
+        std::string_view bound = std::string_view();
+    };
+
+    // Sequence of steps anchored on its first literal
+    class Pattern
+    {
+    public:
+        Pattern(std::initializer_list<Step> steps);
+
+        // Match at the first anchor at or after `from` whose steps all hold. On success fills
+        // captures and end (offset just past the match); otherwise sets anchor to the offset
+        // of an anchor whose match is cut off by the end of the text, or npos if none was found.
+        bool match(std::string_view text, size_t from, std::vector<std::string_view> &captures, size_t &end,
+                   size_t &anchor) const;
+
+        // Length of the anchor literal
+        size_t anchorSize() const { return literals.front().size(); }
+
+    private:
+        std::vector<Literal> literals;
+        std::vector<Literal> bounds; // Empty where a step has no bound
+        std::vector<bool> captures;
+    };
+
+    // Resumable matcher running a pattern over a body that keeps growing. It resumes
+    // where the previous attempt stopped, so feeding the body after every chunk does not
+    // rescan what was already searched.
+    class Matcher
+    {
+    public:
+        explicit Matcher(const Pattern &pattern) : pattern(pattern), position(0), matchEnd(0) {}
+
+        // Find the next match; fills captures and returns false if the text has no complete one yet
+        bool next(std::string_view text, std::vector<std::string_view> &captures);
+
+        // Offset just past the last complete match
+        size_t end() const { return matchEnd; }
+
+    private:
+        const Pattern &pattern;
+        size_t position;
+        size_t matchEnd;
+    };
+}
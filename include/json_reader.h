@@ -0,0 +1,64 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+// Single-pass pull reader over a JSON document.
+// The caller walks objects and arrays in document order and either reads or skips
+// each value, so a response is scanned exactly once and nothing is copied except
+// the scalar values the caller asks for. Malformed input throws ParsingError.
+class JsonReader
+{
+public:
+    enum class Type
+    {
+        Null,
+        Bool,
+        Number,
+        String,
+        Object,
+        Array,
+        End
+    };
+
+    explicit JsonReader(std::string_view json);
+
+    // Get the type of the next value without consuming it
+    Type peek();
+
+    // Enter an object; returns false without consuming anything if the next value is not an object
+    bool beginObject();
+
+    // Advance to the next key of the current object; returns false once the closing brace is consumed
+    bool nextKey(std::string_view &key);
+
+    // Enter an array; returns false without consuming anything if the next value is not an array
+    bool beginArray();
+
+    // Advance to the next element of the current array; returns false once the closing bracket is consumed
+    bool nextElement();
+
+    // Read a scalar into out: strings are unescaped, numbers and booleans are copied
+    // verbatim, and null, objects and arrays are skipped and yield an empty string
+    void readScalar(std::string &out);
+
+    // Read a boolean; any other value is skipped and yields false
+    bool readBool();
+
+    // Read an integer from a number or numeric string; any other value yields 0
+    long long readInteger();
+
+    // Skip the next value, including any nested objects and arrays
+    void skipValue();
+
+private:
+    std::string_view json;
+    size_t pos;
+
+    void skipWhitespace();
+    void expect(char c);
+    void readString(std::string &out);
+    void skipString();
+    std::string_view readNumber();
+    void readLiteral(std::string_view literal);
+    [[noreturn]] void fail(const char *what) const;
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <mutex>
 #include <sstream>
@@ -7,38 +8,249 @@
 #include <iomanip>
 #include <ctime>
 #include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <type_traits>
 
-// Logger class to handle logging messages to a file
+// Severity of a log record; records below the logger's level are discarded
+enum class LogLevel { Debug = 0, Info = 1, Warning = 2, Error = 3, Off = 4 };
+
+// Levels below this are compiled out of LOG_* call sites entirely
+// (e.g. -DLOG_COMPILED_LEVEL=1 removes LOG_DEBUG from a release build)
+#ifndef LOG_COMPILED_LEVEL
+#define LOG_COMPILED_LEVEL 0
+#endif
+
+// Log with "{}" placeholders, e.g. LOG_DEBUG("GET {} took {} ms", url, ms). Arguments are
+// neither evaluated nor formatted unless the level is enabled.
+#define LOG_AT(level, ...)                                                                        \
+    do {                                                                                          \
+        if (static_cast<int>(level) >= LOG_COMPILED_LEVEL && Logger::getInstance().isEnabled(level)) \
+            Logger::getInstance().write(level, __VA_ARGS__);                                      \
+    } while (0)
+#define LOG_DEBUG(...) LOG_AT(LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(LogLevel::Info, __VA_ARGS__)
+#define LOG_WARNING(...) LOG_AT(LogLevel::Warning, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LogLevel::Error, __VA_ARGS__)
+
+// When the log file is rotated and how much rotated output is kept; zero disables a limit
+struct LogRotation {
+    uint64_t maxBytes = 0;           // Rotate once the file reaches this size
+    std::chrono::seconds maxAge{0};  // Rotate once the file's first record is this old, even across runs
+    uint64_t maxTotalBytes = 0;      // Delete the oldest segments beyond this total, active file included
+};
+
+// Minimal "{}" formatter writing into a caller-provided buffer; output is truncated to fit
+namespace LogFormat {
+    struct Buffer {
+        char* data;
+        size_t capacity;
+        size_t length;
+
+        void append(const char* text, size_t count) {
+            count = std::min(count, capacity - length);
+            std::memcpy(data + length, text, count);
+            length += count;
+        }
+    };
+
+    inline void appendValue(Buffer& out, std::string_view value) { out.append(value.data(), value.size()); }
+    inline void appendValue(Buffer& out, const char* value) { appendValue(out, std::string_view(value ? value : "(null)")); }
+    inline void appendValue(Buffer& out, const std::string& value) { appendValue(out, std::string_view(value)); }
+    inline void appendValue(Buffer& out, char value) { out.append(&value, 1); }
+    inline void appendValue(Buffer& out, bool value) { appendValue(out, value ? "true" : "false"); }
+
+    template <typename T>
+    std::enable_if_t<std::is_integral_v<T>> appendValue(Buffer& out, T value) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, static_cast<size_t>(result.ptr - digits));
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_floating_point_v<T>> appendValue(Buffer& out, T value) {
+        char digits[32];
+        int count = std::snprintf(digits, sizeof(digits), "%.6g", static_cast<double>(value));
+        out.append(digits, static_cast<size_t>(std::max(0, std::min(count, int(sizeof(digits)) - 1))));
+    }
+
+    // Copy literal text up to the next "{}" (consumed) or the end; "{{" and "}}" are escapes
+    inline void appendLiteral(Buffer& out, std::string_view format, size_t& pos) {
+        while (pos < format.size()) {
+            char c = format[pos];
+            if ((c == '{' || c == '}') && pos + 1 < format.size() && format[pos + 1] == c) {
+                out.append(&c, 1);
+                pos += 2;
+            } else if (c == '{' && pos + 1 < format.size() && format[pos + 1] == '}') {
+                pos += 2;
+                return;
+            } else {
+                out.append(&c, 1);
+                ++pos;
+            }
+        }
+    }
+
+    // Format into out and return the length written
+    template <typename... Args>
+    size_t format(char* out, size_t capacity, std::string_view format, const Args&... args) {
+        Buffer buffer{out, capacity, 0};
+        size_t pos = 0;
+        ((appendLiteral(buffer, format, pos), appendValue(buffer, args)), ...);
+        appendLiteral(buffer, format, pos);
+        return buffer.length;
+    }
+}
+
+// Logger class to handle logging messages to a file.
+// Callers never touch the file: each record is formatted straight into a slot of a
+// bounded lock-free ring, and a background thread writes the records out in batches.
+// When the ring is full, records are dropped and counted rather than blocking the caller.
+// Records logged before init() are discarded.
+//
+// The writer thread also rotates the file by size and age: it renames the file to a
+// timestamped segment and reopens it, which never blocks callers since they only touch
+// the ring. A second thread gzips rotated segments and enforces the retention cap.
 class Logger {
 public:
-    // Initialize the logger with a file name
-    void init(const std::string& filename);
-    
+    // Get the process-wide logger
+    static Logger& getInstance();
+
+    // Initialize the logger with a file name, the lowest level to record and rotation limits
+    void init(const std::string& filename, LogLevel level = LogLevel::Info, const LogRotation& rotation = LogRotation());
+
+    // Parse a LOG_LEVEL value (DEBUG, INFO, WARNING, ERROR, OFF), case-insensitively;
+    // an empty value gives the fallback and anything else unknown also warns
+    static LogLevel parseLevel(const std::string& name, LogLevel fallback = LogLevel::Info);
+
+    // Change the lowest level recorded
+    void setLevel(LogLevel level) { minLevel.store(static_cast<int>(level), std::memory_order_relaxed); }
+
+    // Whether a record at this level would be written; a single relaxed load
+    bool isEnabled(LogLevel level) const {
+        return static_cast<int>(level) >= minLevel.load(std::memory_order_relaxed);
+    }
+
+    // Format a "{}" message on the stack and queue it; prefer the LOG_* macros, which
+    // skip evaluating the arguments when the level is disabled
+    template <typename... Args>
+    void write(LogLevel level, std::string_view format, const Args&... args) {
+        if (!isEnabled(level)) {
+            return;
+        }
+        char message[MAX_RECORD];
+        size_t length = LogFormat::format(message, sizeof(message), format, args...);
+        log(level, levelName(level), std::string_view(message, length));
+    }
+
     // Log an info message
     void info(const std::string& message);
-    
+
     // Log a warning message
     void warning(const std::string& message);
-    
+
     // Log an error message
     void error(const std::string& message, const std::string& functionName, const std::string& fileName, int lineNumber);
-    
+
     // Log a debug message
     void debug(const std::string& message);
 
     // Log a retry attempt for a failed network request
     void logRetryAttempt(const std::string& url, int attemptNumber);
-    
+
 private:
-    std::ofstream logFile; // Log file stream
-    std::mutex logMutex; // Mutex to ensure thread-safe logging
-    
-    // Log a message with a specific level
-    void log(const std::string& level, const std::string& message);
-    
-    // Get the current timestamp
-    std::string getCurrentTimestamp();
-    
+    Logger();
+
+    // Write out everything still queued and stop the writer thread
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // Ring capacity (a power of two) and the longest record; longer ones are truncated
+    static const size_t RING_SLOTS = 4096;
+    static const size_t MAX_RECORD = 512;
+
+    // Writer wakes up this often to write and flush queued records, and early whenever
+    // producers have filled another half of the ring
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{20};
+
+    // After a failed rotation, wait this long (or for another maxBytes of growth) before retrying
+    static constexpr std::chrono::seconds ROTATE_RETRY_INTERVAL{60};
+
+    // One queued record; sequence tells producers and the writer whose turn the slot is
+    struct Slot {
+        std::atomic<size_t> sequence;
+        size_t length;
+        char text[MAX_RECORD];
+    };
+
+    std::ofstream logFile; // Log file stream, touched only by the writer thread after init
+    std::string logPath;
+    LogRotation rotation;
+    uint64_t fileBytes; // Size of the active file
+    std::chrono::system_clock::time_point fileStartedAt; // Time of the active file's first record
+    std::chrono::steady_clock::time_point rotateRetryAt; // No rotation attempt before this...
+    uint64_t rotateRetryBytes; // ...unless the file has reached this size
+
+    // Rotated segments waiting for compression, and the thread compressing them
+    std::mutex compressMutex;
+    std::condition_variable wakeCompressor;
+    std::deque<std::string> segments;
+    bool compressorStopping;
+    std::thread compressor;
+    std::mutex logMutex; // Guards init and the writer's wakeup
+    std::condition_variable wakeWriter;
+    std::unique_ptr<Slot[]> ring;
+    alignas(64) std::atomic<size_t> enqueuePos; // Next slot producers claim
+    size_t dequeuePos; // Next slot the writer reads
+    std::atomic<uint64_t> dropped; // Records lost to a full ring since last reported
+    std::atomic<bool> running;
+    std::atomic<int> minLevel; // Off until init
+    std::thread writer;
+
+    static const char* levelName(LogLevel level);
+
+    // Log a message with a specific level, labelled with the given name
+    void log(LogLevel level, const char* label, std::string_view message);
+
+    // Claim a slot and format a record into it; false if the ring is full
+    bool push(const char* level, std::string_view message);
+
+    // Write every completed record to the file; returns how many were written
+    size_t drain();
+
+    // Writer thread loop
+    void run();
+
+    // Open the log file for appending and note its size and the time of its first record;
+    // false if it cannot be opened
+    bool openFile();
+
+    // Rotate if the active file is over its size or age limit, backing off after a failure
+    void rotateIfDue();
+
+    // Rename the active file to a timestamped segment, reopen it and queue the segment
+    // for compression; false if the rename failed and the old file is still active
+    bool rotate();
+
+    // Compressor thread loop
+    void compressSegments();
+
+    // Delete the oldest rotated segments until everything fits in maxTotalBytes
+    void enforceRetention();
+
+    // Write the current local time into out (19 chars), reformatting only when the second changes
+    static void formatTimestamp(char* out);
+
     // Get the stack trace
     std::string getStackTrace();
 };
@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+// Read-only memory mapping of a whole file
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // Map the file; returns false if it is missing, empty or cannot be mapped
+    bool open(const std::string &path);
+
+    // Unmap the file (required on Windows before the file can be replaced)
+    void close();
+
+    // View of the mapped bytes (empty when nothing is mapped)
+    std::string_view view() const { return std::string_view(data, length); }
+
+private:
+    const char *data;
+    size_t length;
+#ifdef _WIN32
+    void *fileHandle;
+    void *mappingHandle;
+#endif
+};
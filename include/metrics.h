@@ -0,0 +1,99 @@
+#pragma once
+#include "network_utils.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+
+// Process-wide request metrics, keyed by endpoint (e.g. "store.steampowered.com/api/appdetails",
+// "GetPlayerSummaries", "steamdb.info/search"). Recording is lock-free: every counter and
+// histogram bucket is a relaxed atomic, and the registry lock is only taken shared to find
+// an endpoint, or exclusively the first time an endpoint is seen.
+class Metrics
+{
+public:
+    // Log-linear latency histogram in microseconds, HDR style: 32 linear sub-buckets per
+    // power of two keep every recorded value within about 3% of its bucket
+    class Histogram
+    {
+    public:
+        Histogram();
+
+        void record(uint64_t micros);
+
+        uint64_t count() const;
+
+        // Value at the given percentile (0-100), in microseconds
+        uint64_t percentile(double percent) const;
+
+    private:
+        static const int SUB_BUCKET_BITS = 5;
+        static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+        static const int MAX_MAGNITUDE = 40; // Values up to 2^41 us, about 25 days
+        static const int BUCKETS = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+        static int bucketFor(uint64_t micros);
+        static uint64_t bucketMidpoint(int bucket);
+
+        std::array<std::atomic<uint64_t>, BUCKETS> buckets;
+    };
+
+    // Counters and phase histograms of one endpoint
+    struct Endpoint
+    {
+        std::atomic<uint64_t> requests{0};
+        std::atomic<uint64_t> failures{0}; // Transport errors and 4xx/5xx responses
+        std::atomic<uint64_t> retries{0};
+        std::atomic<uint64_t> cacheHits{0};   // Served fresh from the response cache
+        std::atomic<uint64_t> notModified{0}; // Revalidated with a 304
+        std::atomic<uint64_t> wireBytes{0};
+        std::atomic<uint64_t> decodedBytes{0};
+        std::atomic<uint64_t> rateLimitWaitMicros{0};
+        Histogram dns;
+        Histogram connect;
+        Histogram tls;
+        Histogram firstByte;
+        Histogram total;
+        Histogram rateLimitWait;
+    };
+
+    // Get the shared registry
+    static Metrics &getInstance();
+
+    // Endpoint key for a URL: the Steam Web API method, or host plus path without IDs
+    static std::string endpointName(const std::string &url);
+
+    // Record a completed transfer: phase timings from curl_easy_getinfo, bytes and status
+    void recordTransfer(const std::string &url, const NetworkUtils::HttpResponse &response);
+
+    // Record a transfer that failed before a response arrived
+    void recordFailure(const std::string &url);
+
+    void recordRetry(const std::string &url);
+    void recordCacheHit(const std::string &url);
+
+    // Record time spent waiting for a rate-limit permit
+    void recordRateLimitWait(const std::string &url, std::chrono::nanoseconds wait);
+
+    // Whether anything has been recorded
+    bool empty() const;
+
+    // Print per-endpoint counters and p50/p95/p99 of each phase
+    void report(std::ostream &out) const;
+
+private:
+    Metrics() = default;
+    Metrics(const Metrics &) = delete;
+    Metrics &operator=(const Metrics &) = delete;
+
+    // Find or create the entry for a URL's endpoint
+    Endpoint &endpoint(const std::string &url);
+
+    mutable std::shared_mutex registryMutex;
+    std::map<std::string, std::unique_ptr<Endpoint>> endpoints;
+};
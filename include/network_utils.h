@@ -1,9 +1,123 @@
 #pragma once
+#include <curl/curl.h>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <future>
+#include <functional>
 #include "error_handling.h"
+#include "response_cache.h"
 
 namespace NetworkUtils
 {
+    // Stage timings of a transfer, in milliseconds from its start (curl_easy_getinfo)
+    struct TransferTiming
+    {
+        double dnsMs = 0;       // Name resolved
+        double connectMs = 0;   // TCP connected
+        double tlsMs = 0;       // TLS handshake done (0 for plain HTTP or a reused connection)
+        double firstByteMs = 0; // First response byte received
+        double totalMs = 0;     // Transfer complete
+        curl_off_t bytes = 0;        // Body bytes on the wire, before decompression
+        curl_off_t decodedBytes = 0; // Body bytes after decompression
+    };
+
+    // Body bytes moved by all transfers since startup
+    struct TransferTotals
+    {
+        uint64_t transfers = 0;
+        uint64_t wireBytes = 0;
+        uint64_t decodedBytes = 0;
+    };
+
+    // Running totals of wire and decoded body bytes, for reporting compression savings
+    TransferTotals transferTotals();
+
+    // Receives live progress of the transfers made on the current thread
+    class ProgressListener
+    {
+    public:
+        virtual ~ProgressListener() = default;
+
+        // Called as data arrives; total is 0 when the server did not announce a length
+        virtual void onProgress(const std::string &host, curl_off_t received, curl_off_t total) = 0;
+
+        // Called once a transfer has finished
+        virtual void onComplete(const std::string &host, const TransferTiming &timing) = 0;
+    };
+
+    // Installs a progress listener for synchronous fetches on this thread while in scope
+    class ProgressScope
+    {
+    public:
+        explicit ProgressScope(ProgressListener *listener);
+        ~ProgressScope();
+        ProgressScope(const ProgressScope &) = delete;
+        ProgressScope &operator=(const ProgressScope &) = delete;
+
+    private:
+        ProgressListener *previous;
+    };
+
+    // Status, headers and body of a completed HTTP transfer
+    struct HttpResponse
+    {
+        long status = 0;
+        std::string body;
+        std::vector<std::pair<std::string, std::string>> headers; // Names lowercased
+        std::chrono::seconds retryAfter{0};
+        TransferTiming timing;
+        bool notModified = false; // Body reused from the response cache after a 304
+        bool stopped = false;     // Receiver stopped the transfer early; the body is partial
+
+        // Cache entry being revalidated and the conditional headers sent for it
+        std::shared_ptr<const ResponseCache::Entry> cached;
+        std::shared_ptr<curl_slist> requestHeaders;
+
+        // Value of a header by lowercase name, or empty if absent
+        std::string header(std::string_view name) const;
+    };
+
+    // Fetch a URL over a pooled keep-alive connection after waiting for a permit from the
+    // host's rate limit; HTTP error statuses are returned, only transport failures throw
+    HttpResponse fetchResponse(const std::string &url);
+
+    // Fetch the body of a web page; throws HttpError for 4xx/5xx responses.
+    // Fresh responses come from the response cache, stale ones are revalidated, and
+    // concurrent fetches of the same normalized URL share a single request.
+    std::string fetchPage(const std::string &url);
+
+    // Receives the body received so far after each chunk; returns false to stop the transfer
+    using StreamCallback = std::function<bool(const std::string &received)>;
+
+    // Fetch a page incrementally so the caller can parse while it downloads and abort once
+    // it has what it needs. Throws HttpError for 4xx/5xx. A fresh cached body, or the body
+    // of an identical fetch already in flight, is handed over in one piece; when that body
+    // was cut short and the caller wants more, the page is fetched again. Only pages that
+    // ran to the end are cached, and stopping early closes the pooled connection.
+    HttpResponse fetchStreaming(const std::string &url, const StreamCallback &onData);
+
+    // Canonical form of a URL for request coalescing: lowercase scheme and host,
+    // no fragment, query parameters sorted
+    std::string normalizeUrl(const std::string &url);
+
+    // Point a handle at a URL and capture the body and headers into a response; a stale
+    // cached copy of the URL is revalidated with If-None-Match / If-Modified-Since
+    void prepareTransfer(CURL *curl, const std::string &url, HttpResponse &response);
+
+    // Fill in the status and timing of a finished transfer, feed it back to the rate limiter
+    // and update the response cache (a 304 becomes a 200 carrying the cached body)
+    void completeTransfer(CURL *curl, const std::string &url, HttpResponse &response);
+
+    // Decide whether a failed attempt (0-based) may be retried. Only transport errors,
+    // 408, 429 and 5xx qualify, and each retry is paid from the global retry budget.
+    // On success sets the jittered exponential backoff, stretched to any Retry-After.
+    bool planRetry(const std::exception_ptr &error, int attempt, int maxRetries, int retryDelay,
+                   std::chrono::milliseconds &delay);
+
     // Check if there is an active internet connection
     bool checkInternetConnection();
 
@@ -13,9 +127,14 @@ namespace NetworkUtils
     // Construct a URL by combining a base URL and a query string
     std::string constructUrl(const std::string &baseUrl, const std::string &query);
 
-    // Retry failed network requests with exponential backoff
+    // Retry failed network requests with jittered exponential backoff
     std::string fetchPageWithRetry(const std::string &url, int maxRetries = 3, int retryDelay = 2000);
 
+    // Queue a fetch on the shared curl_multi engine so many requests run concurrently;
+    // served from the response cache when fresh, and joins an identical fetch that is
+    // already in flight instead of sending another
+    std::future<std::string> fetchPageAsync(const std::string &url, int maxRetries = 3, int retryDelay = 2000);
+
     // Steam API specific functions
     std::string buildSteamApiUrl(const std::string &endpoint, const std::string &additionalParams = "");
     std::string fetchSteamApiData(const std::string &endpoint, const std::string &additionalParams = "");
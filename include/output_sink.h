@@ -0,0 +1,116 @@
+#pragma once
+#include "batch_runner.h"
+#include "steam_api_helper.h"
+#include <cstdio>
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// Machine-readable writer for bulk results.
+// Records are serialized field by field straight into one large reusable buffer that is
+// written out with a single fwrite when it fills up, so exports of many records cost no
+// iostream formatting and no per-line flush. A background thread writes out records that
+// have been pending for a moment, so a slow batch still shows its results as they come.
+class OutputSink
+{
+public:
+    // Create the sink for a format name ("ndjson" or "csv"); nullptr for anything else
+    static std::unique_ptr<OutputSink> create(const std::string &format, std::FILE *out);
+
+    virtual ~OutputSink();
+
+    // Write one batch lookup result
+    void write(const BatchResult &result);
+
+    // Write one sale listing
+    void write(const SteamSaleInfo &sale);
+
+    // Write out everything buffered so far
+    void flush();
+
+protected:
+    explicit OutputSink(std::FILE *out);
+
+    // Record framing and typed fields implemented by each format; `kind` names the record schema
+    virtual void beginRecord(std::string_view kind) = 0;
+    virtual void stringField(std::string_view name, std::string_view value) = 0;
+    virtual void numberField(std::string_view name, uint64_t value) = 0;
+    virtual void boolField(std::string_view name, bool value) = 0;
+    virtual void endRecord() = 0;
+
+    // Append an unsigned integer without going through a stream
+    void appendNumber(uint64_t value);
+
+    std::string buffer;
+
+private:
+    // Write out the buffer if it is full; otherwise a record written to an empty buffer
+    // starts the clock for the flusher
+    void recordWritten(bool first);
+
+    // Write out the buffer; the caller holds the mutex
+    void writeOut();
+
+    // Flusher thread loop
+    void flushPending();
+
+    std::FILE *out;
+    std::mutex mutex; // Guards the buffer and the stream between writers and the flusher
+    std::condition_variable wakeFlusher;
+    std::chrono::steady_clock::time_point pendingSince; // When the oldest buffered record was written
+    bool stopping = false;
+    std::thread flusher;
+};
+
+// One JSON object per line
+class NdjsonSink : public OutputSink
+{
+public:
+    explicit NdjsonSink(std::FILE *out);
+
+protected:
+    void beginRecord(std::string_view kind) override;
+    void stringField(std::string_view name, std::string_view value) override;
+    void numberField(std::string_view name, uint64_t value) override;
+    void boolField(std::string_view name, bool value) override;
+    void endRecord() override;
+
+private:
+    // Append a quoted, escaped JSON string
+    void appendString(std::string_view value);
+
+    void appendName(std::string_view name);
+
+    bool firstField = true;
+};
+
+// RFC 4180 CSV with a header row whenever the record schema changes
+class CsvSink : public OutputSink
+{
+public:
+    explicit CsvSink(std::FILE *out);
+
+protected:
+    void beginRecord(std::string_view kind) override;
+    void stringField(std::string_view name, std::string_view value) override;
+    void numberField(std::string_view name, uint64_t value) override;
+    void boolField(std::string_view name, bool value) override;
+    void endRecord() override;
+
+private:
+    // Append a value, quoting it only when it contains separators, quotes or newlines
+    void appendCell(std::string_view value);
+
+    void separate(std::string_view name);
+
+    std::string currentKind;
+    std::string header;
+    size_t recordStart = 0;
+    bool headerPending = false;
+    bool firstField = true;
+};
@@ -0,0 +1,87 @@
+#pragma once
+#include "game_data.h"
+#include "steam_api_helper.h"
+#include "mapped_file.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+
+// On-disk cache of GameData, SteamGameInfo and SteamSaleInfo shared across runs.
+// The cache file is memory-mapped at startup and records are decoded only when looked up.
+// Entries expire after CACHE_EXPIRY_HOURS, and the whole cache is bypassed when
+// ENABLE_CACHING is false. flush() rewrites the file atomically (temp file + rename),
+// so a crash never leaves a torn cache behind.
+//
+// File layout (native byte order):
+//   header: "SDBC" | u32 version | u32 record count
+//   record: u32 record length | i64 stored-at (unix seconds) | str key | payload
+//   str:    u32 length | bytes;  string list: u32 count | str...;  bool: u8
+class PersistentCache
+{
+public:
+    // Get the shared cache instance
+    static PersistentCache &getInstance();
+
+    // Open (or create on first flush) the cache file, reading settings from Config
+    void open(const std::string &path);
+
+    // Check if caching is enabled
+    bool isEnabled() const;
+
+    // Look up or store scraped game data by search term
+    bool loadGame(const std::string &gameName, GameData &out);
+    void storeGame(const std::string &gameName, const GameData &data);
+
+    // Look up or store Steam store details by app ID
+    bool loadGameInfo(const std::string &appId, SteamGameInfo &out);
+    void storeGameInfo(const SteamGameInfo &info);
+
+    // Look up or store Steam price/sale details by app ID and store country, since
+    // prices and currency differ per country
+    bool loadSaleInfo(const std::string &appId, SteamSaleInfo &out, const std::string &countryCode = "US");
+    void storeSaleInfo(const SteamSaleInfo &info, const std::string &countryCode = "US");
+
+    // Atomically rewrite the cache file with every unexpired entry
+    void flush();
+
+private:
+    struct Entry
+    {
+        int64_t storedAt;
+        bool mapped;
+        std::string_view mappedPayload;
+        std::string ownedPayload;
+
+        std::string_view payload() const { return mapped ? mappedPayload : std::string_view(ownedPayload); }
+    };
+
+    PersistentCache();
+    ~PersistentCache();
+    PersistentCache(const PersistentCache &) = delete;
+    PersistentCache &operator=(const PersistentCache &) = delete;
+
+    // Rebuild the index from the mapped file
+    void loadIndex();
+
+    // Find an unexpired entry's payload (caller holds cacheMutex)
+    bool findPayload(const std::string &key, std::string_view &payload);
+
+    // Insert a freshly serialized payload and flush once enough writes accumulate
+    void insert(const std::string &key, std::string payload);
+
+    // Write the file without taking the lock
+    void flushLocked();
+
+    static const uint32_t FILE_VERSION = 1;
+    static const size_t FLUSH_EVERY = 64;
+
+    std::string filePath;
+    bool enabled;
+    int64_t ttlSeconds;
+    size_t dirtyCount;
+    MappedFile mappedFile;
+    std::unordered_map<std::string, Entry> entries;
+    std::mutex cacheMutex;
+};
@@ -1,17 +1,88 @@
 #pragma once
+#include <atomic>
 #include <chrono>
-#include <thread>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
 
-// RateLimiter class to control the rate of requests
+// Process-wide request rate limiter with one bucket per remote host.
+// Each limit is a GCRA cell (a token bucket kept as a single atomic "theoretical
+// arrival time"), so concurrent callers reserve permits with a CAS instead of a lock
+// and each one sleeps exactly until its own slot. Hosts without a bucket are unlimited.
+//
+// The per-minute rate adapts AIMD-style to server feedback: a 429/503 halves it and
+// pauses the host for any Retry-After delay, and each successful (2xx/3xx) response adds
+// back a fraction of the configured rate, which acts as the ceiling. The rate is halved
+// once per congestion event, not once per rejected request that was already in flight.
 class RateLimiter {
 public:
-    // Constructor to initialize the rate limiter with a specific rate
-    RateLimiter(int requestsPerMinute = 30);
-    
-    // Wait for the next allowed request time
-    void waitForNext();
-    
+    using Clock = std::chrono::steady_clock;
+
+    // Get the shared limiter (reads the limits from Config on first use)
+    static RateLimiter& getInstance();
+
+    // Reserve a permit for the host of the URL; returns when the request may be sent,
+    // never earlier than `earliest`
+    Clock::time_point reserve(const std::string& url, Clock::time_point earliest = Clock::now());
+
+    // Block until a permit for the host of the URL is available
+    void acquire(const std::string& url);
+
+    // Feed a response status back into the host's adaptive rate
+    void recordResponse(const std::string& url, long status, std::chrono::seconds retryAfter);
+
+    // Credit the global retry budget for a new request
+    void recordRequest();
+
+    // Spend one retry from the global budget; false once retries exceed their share of traffic
+    bool tryRetry();
+
 private:
-    std::chrono::steady_clock::time_point lastRequest; // Time point of the last request
-    std::chrono::milliseconds delay; // Delay between requests
+    // One "N requests per period with burst B" limit
+    class Cell {
+    public:
+        // A rate of zero or less disables the cell
+        void configure(int requestsPerPeriod, std::chrono::nanoseconds period, int burst);
+
+        // Reserve the next slot at or after `arrival` (nanosecond ticks); returns the slot time
+        int64_t reserve(int64_t arrival);
+
+        // Multiplicative decrease: halve the rate, unless it was already cut within the last
+        // interval or Retry-After window, and hold all slots until `resumeAt`
+        void throttle(int64_t now, int64_t resumeAt);
+
+        // Additive increase: step the rate back towards the configured one
+        void recover();
+
+    private:
+        int64_t baseInterval = 0;         // Interval at the configured rate (0 = unlimited)
+        int64_t tolerance = 0;            // How far ahead of the sustained rate a burst may run
+        std::atomic<int64_t> interval{0}; // Current nanoseconds between permits
+        std::atomic<int64_t> theoreticalArrival{0};
+        std::atomic<int64_t> throttledUntil{0}; // Further throttles before this tick are ignored
+    };
+
+    struct Bucket {
+        Cell perMinute;
+        Cell perHour;
+    };
+
+    RateLimiter();
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    // Create the bucket of a host from the <prefix>_RATE_LIMIT_PER_MINUTE/_PER_HOUR and
+    // <prefix>_RATE_BURST config keys
+    void addHost(const std::string& host, const std::string& prefix, int perMinute, int perHour, int burst);
+
+    // Bucket for the host of a URL, or nullptr if the host is unlimited
+    Bucket* findBucket(const std::string& url);
+
+    // Buckets are created in the constructor and never change afterwards,
+    // so lookups need no lock
+    std::unordered_map<std::string, std::unique_ptr<Bucket>> buckets;
+
+    // Retry budget in tenths of a retry
+    std::atomic<int> retryBudget;
 };
@@ -0,0 +1,69 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Process-wide HTTP response cache keyed by normalized URL.
+// Bodies are kept with their ETag / Last-Modified validators: a fresh entry is served
+// without touching the network, a stale one is revalidated with a conditional request
+// and reused when the server answers 304 Not Modified. Memory is bounded by an LRU.
+class ResponseCache
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Cached response; entries are immutable and replaced as a whole
+    struct Entry
+    {
+        std::shared_ptr<const std::string> body;
+        std::string etag;
+        std::string lastModified;
+        Clock::time_point freshUntil;
+
+        bool isFresh(Clock::time_point now = Clock::now()) const { return now < freshUntil; }
+        bool hasValidators() const { return !etag.empty() || !lastModified.empty(); }
+    };
+
+    // Get the shared cache (reads HTTP_CACHE_TTL_SECONDS and HTTP_CACHE_MEMORY_MB on first use)
+    static ResponseCache &getInstance();
+
+    // Entry for a key, fresh or stale, or null if none
+    std::shared_ptr<const Entry> find(const std::string &key);
+
+    // Cache a 200 response unless its Cache-Control forbids it; returns the stored entry or null
+    std::shared_ptr<const Entry> store(const std::string &key, const std::string &body, const std::string &cacheControl,
+                                       const std::string &etag, const std::string &lastModified);
+
+    // Renew a stale entry after a 304; validators sent with the 304 replace the old ones
+    std::shared_ptr<const Entry> refresh(const std::string &key, const std::shared_ptr<const Entry> &entry,
+                                         const std::string &cacheControl, const std::string &etag,
+                                         const std::string &lastModified);
+
+private:
+    struct Slot
+    {
+        std::shared_ptr<const Entry> entry;
+        std::list<std::string>::iterator recent;
+    };
+
+    ResponseCache();
+    ResponseCache(const ResponseCache &) = delete;
+    ResponseCache &operator=(const ResponseCache &) = delete;
+
+    // Seconds a response stays fresh, or -1 if it must not be stored
+    long long freshnessSeconds(const std::string &cacheControl) const;
+
+    // Insert or replace an entry and evict least recently used ones over the byte limit
+    void put(const std::string &key, std::shared_ptr<const Entry> entry);
+
+    std::chrono::seconds defaultTtl;
+    size_t maxBytes;
+    size_t usedBytes;
+    std::mutex cacheMutex;
+    std::unordered_map<std::string, Slot> entries;
+    std::list<std::string> recentKeys; // Most recently used first
+};
@@ -1,6 +1,5 @@
 #pragma once
 #include "game_data.h"
-#include "rate_limiter.h"
 #include <string>
 #include <memory>
 #include "network_utils.h"
@@ -18,12 +17,13 @@ public:
     GameData searchGame(const std::string& gameName);
     
 private:
-    // Fetch the HTML content of a web page
-    std::string fetchPage(const std::string& url);
+    // Fetch a web page incrementally; onData sees the body received so far after each
+    // chunk and returns false once it has what it needs, which stops the download
+    std::string fetchPage(const std::string& url, const NetworkUtils::StreamCallback& onData);
     
-    // Parse the HTML content to extract game data
-    GameData parseGameData(const std::string& html);
-    
-    // Rate limiter to control the rate of requests
-    std::unique_ptr<RateLimiter> rateLimiter;
+    // Throw the most specific error for a search page without a result row
+    void reportSearchFailure(const std::string& html);
+
+    // Fill in price, Metacritic, tag and review details from the app page as it arrives
+    void parseGameDetails(GameData& gameData);
 };
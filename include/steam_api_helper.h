@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <future>
 
 struct SteamGameInfo
 {
@@ -46,6 +47,24 @@ struct SteamSaleInfo
     std::string saleEndDate;
     std::string headerImage;
     bool isHighlighted;
+    std::string error; // Why the lookup failed; empty when it completed, found (name set) or not
+};
+
+// Sections of an appdetails document. Each method asks only for the sections it reads,
+// which keeps screenshots and movies off the wire. "basic" is still heavy: besides the
+// name it carries the full descriptions and the platform requirements HTML, so price
+// lookups take names from the local catalog and request it only as a fallback.
+enum AppDetailsField : unsigned
+{
+    APP_FIELD_BASIC = 1u << 0, // name, is_free, header_image, descriptions, pc/mac/linux requirements
+    APP_FIELD_PRICE_OVERVIEW = 1u << 1,
+    APP_FIELD_DEVELOPERS = 1u << 2,
+    APP_FIELD_PUBLISHERS = 1u << 3,
+    APP_FIELD_RELEASE_DATE = 1u << 4,
+    APP_FIELD_METACRITIC = 1u << 5,
+    APP_FIELD_RECOMMENDATIONS = 1u << 6,
+    APP_FIELD_GENRES = 1u << 7,
+    APP_FIELD_CATEGORIES = 1u << 8
 };
 
 class SteamApiHelper
@@ -64,7 +83,15 @@ public:
     std::vector<SteamSaleInfo> getFeaturedSales();
     std::vector<SteamSaleInfo> getSpecialOffers();
     bool isGameOnSale(const std::string &appId);
-    SteamSaleInfo getSaleInfo(const std::string &appId);
+    SteamSaleInfo getSaleInfo(const std::string &appId, const std::string &countryCode = "US");
+
+    // Price and sale info for many apps, packing up to APPDETAILS_BATCH_SIZE app IDs into
+    // each price_overview-only request; results follow the order of appIds. Each result is
+    // found (name set), not found (name and error empty) or failed (error set).
+    std::vector<SteamSaleInfo> getSaleInfoBatch(const std::vector<std::string> &appIds, const std::string &countryCode = "US");
+
+    // App IDs per batched appdetails request
+    static const size_t APPDETAILS_BATCH_SIZE = 100;
 
     // Player information methods
     SteamPlayerInfo getPlayerInfo(const std::string &steamId);
@@ -74,17 +101,17 @@ public:
     std::string resolveVanityUrl(const std::string &vanityUrl);
     bool isValidSteamId(const std::string &steamId);
 
-    // Rate limiting
-    void respectRateLimit();
+    // Resolve an App ID, popular alias or game name to the best matching App ID (empty if none)
+    std::string findAppId(const std::string &nameOrAppId);
 
 private:
     bool apiKeyValid;
-    long lastApiCall;
-    int callsInLastMinute;
-    std::vector<long> recentCalls;
 
     // Helper methods
     std::string makeApiCall(const std::string &endpoint, const std::string &params = "");
-    void updateRateLimit();
-    std::string parseJsonValue(const std::string &json, const std::string &key);
+    std::future<std::string> makeApiCallAsync(const std::string &endpoint, const std::string &params = "");
+    std::string buildApiUrl(const std::string &endpoint, const std::string &params);
+    static std::string appDetailsParams(const std::string &appIds, unsigned fields, const std::string &countryCode = "US");
+    SteamGameInfo parseGameInfo(const std::string &appId, const std::string &response);
+    SteamSaleInfo parseSaleInfo(const std::string &appId, const std::string &response);
 };
@@ -0,0 +1,34 @@
+#pragma once
+#include "html_scanner.h"
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
+// steamdb.info page layout as HtmlScanner patterns, shared by the scraper and the
+// scanner benchmark so both exercise exactly what ships
+namespace SteamdbPatterns
+{
+    // Search results row: a <tr> carrying the app ID, then the type cell, linked name cell and
+    // release date cell, all within that row
+    inline const HtmlScanner::Pattern RESULT_ROW{{false, "<tr"}, {false, "data-appid=\"", ">"}, {true, "\"", ">"}, {false, ">"},
+                                                {false, "</td>", "</tr>"}, {false, "<td", "</tr>"}, {false, "<a", "</tr>"},
+                                                {false, ">"}, {true, "</a>", "</tr>"}, {false, "</td>", "</tr>"},
+                                                {false, "<td", "</tr>"}, {false, ">"}, {true, "</td>", "</tr>"}};
+
+    // Value cells following a "<label></td>" cell on the app page
+    inline const HtmlScanner::Pattern CURRENT_PRICE{{false, ">Current Price:</td>"}, {false, "<td"}, {false, ">"}, {true, "</td>"}};
+    inline const HtmlScanner::Pattern LOWEST_PRICE{{false, ">Lowest Price:</td>"}, {false, "<td"}, {false, ">"}, {true, "</td>"}};
+    inline const HtmlScanner::Pattern USER_REVIEWS{{false, "User Reviews:</td>"}, {false, "<td"}, {false, ">"}, {true, "</td>"}};
+    inline const HtmlScanner::Pattern METACRITIC{{false, "Metacritic Score:</td>"}, {false, "<td"}, {false, "<a"}, {false, ">"}, {true, "</a>"}};
+    inline const HtmlScanner::Pattern APP_TAG{{false, "class=\"app-tag\""}, {false, ">"}, {true, "</a>"}};
+
+    // Error message box on a failed search: a <div> whose own tag has class="error"
+    inline const HtmlScanner::Pattern ERROR_BOX{{false, "<div"}, {false, "class=\"error\"", ">"}, {false, ">"}, {true, "</div>"}};
+
+    // Metacritic matches are only taken when the linked text is a score
+    inline bool isScore(std::string_view text)
+    {
+        return !text.empty() && std::all_of(text.begin(), text.end(), [](unsigned char c)
+                                            { return std::isdigit(c); });
+    }
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Record a span over the rest of the enclosing scope, e.g. TRACE_SCOPE("fetchPage", "network", url).
+// Name and category must be string literals; the optional detail is copied only while tracing.
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(...) Tracer::Scope TRACE_CONCAT(traceScope, __LINE__)(__VA_ARGS__)
+
+// Timeline of spans in Chrome Trace Event JSON, viewable in chrome://tracing or ui.perfetto.dev.
+// Nothing is recorded until start(); until then a span costs a single relaxed load. Each
+// thread appends to its own buffer, so recording threads never contend with one another.
+class Tracer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Span from construction to destruction on the calling thread
+    class Scope
+    {
+    public:
+        Scope(const char *name, const char *category, std::string_view detail = std::string_view())
+        {
+            if (Tracer::enabled())
+            {
+                this->name = name;
+                this->category = category;
+                this->detail.assign(detail);
+                start = Clock::now();
+            }
+        }
+
+        ~Scope()
+        {
+            if (name)
+            {
+                Tracer::getInstance().complete(name, category, start, Clock::now(), detail);
+            }
+        }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        const char *name = nullptr;
+        const char *category = nullptr;
+        std::string detail;
+        Clock::time_point start;
+    };
+
+    // Get the process-wide tracer
+    static Tracer &getInstance();
+
+    // Whether spans are being recorded
+    static bool enabled() { return active.load(std::memory_order_relaxed); }
+
+    // Start recording spans for write() to save to path
+    void start(const std::string &path);
+
+    // Record a span that ran on the calling thread
+    void complete(const char *name, const char *category, Clock::time_point start, Clock::time_point end,
+                  std::string_view detail = std::string_view());
+
+    // Record a span of work that is not tied to a thread, such as a transfer driven by
+    // curl_multi; spans sharing an id are drawn on one track
+    void async(const char *name, const char *category, uint64_t id, Clock::time_point start, Clock::time_point end,
+               std::string_view detail = std::string_view());
+
+    // A fresh id for async()
+    uint64_t nextAsyncId();
+
+    // Label the calling thread in the trace
+    void nameThread(const std::string &name);
+
+    // Stop recording and write every span to the file given to start(); false if it cannot be written
+    bool write();
+
+private:
+    struct Event
+    {
+        const char *name;
+        const char *category;
+        char phase; // 'X' for a thread span, 'b' for an async span
+        uint64_t id;
+        int64_t startNs; // Since start()
+        int64_t durationNs;
+        std::string detail;
+    };
+
+    // Spans recorded by one thread; the mutex is only contended while write() runs
+    struct ThreadBuffer
+    {
+        std::mutex mutex;
+        uint32_t tid;
+        std::string name;
+        std::vector<Event> events;
+    };
+
+    Tracer() = default;
+    Tracer(const Tracer &) = delete;
+    Tracer &operator=(const Tracer &) = delete;
+
+    // The calling thread's buffer, registered on first use
+    ThreadBuffer &threadBuffer();
+
+    void record(const char *name, const char *category, char phase, uint64_t id, Clock::time_point start,
+                Clock::time_point end, std::string_view detail);
+
+    inline static std::atomic<bool> active{false};
+    std::string path;
+    Clock::time_point origin;
+    std::mutex registryMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::atomic<uint64_t> asyncIds{0};
+};
@@ -0,0 +1,250 @@
+#include "async_fetcher.h"
+#include "error_handling.h"
+#include "rate_limiter.h"
+#include "logger.h"
+#include "metrics.h"
+#include "tracer.h"
+#include <algorithm>
+
+AsyncFetcher::AsyncFetcher() : stopping(false)
+{
+    // The pool owns curl_global_init, so it must outlive this instance
+    ConnectionPool::getInstance();
+
+    multi = curl_multi_init();
+    if (!multi)
+    {
+        throw NetworkError("Failed to initialize CURL multi handle");
+    }
+    worker = std::thread(&AsyncFetcher::run, this);
+}
+
+AsyncFetcher::~AsyncFetcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    curl_multi_wakeup(multi);
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+    curl_multi_cleanup(multi);
+}
+
+AsyncFetcher &AsyncFetcher::getInstance()
+{
+    static AsyncFetcher instance;
+    return instance;
+}
+
+std::shared_future<AsyncFetcher::Body> AsyncFetcher::fetch(const std::string &url, int maxRetries, int retryDelay,
+                                                           std::function<void()> onDone)
+{
+    auto request = std::make_unique<Request>();
+    request->url = url;
+    request->attempt = 0;
+    request->maxRetries = std::max(1, maxRetries);
+    request->retryDelay = retryDelay;
+    request->traceId = 0;
+    request->onDone = std::move(onDone);
+    request->queuedAt = std::chrono::steady_clock::now();
+    // Schedule against the host's rate limit instead of blocking the caller
+    request->startAt = RateLimiter::getInstance().reserve(url);
+    Metrics::getInstance().recordRateLimitWait(url, request->startAt - request->queuedAt);
+    if (Tracer::enabled())
+    {
+        request->traceId = Tracer::getInstance().nextAsyncId();
+        Tracer::getInstance().async("rate-limit wait", "network", request->traceId, request->queuedAt,
+                                    std::max(request->queuedAt, request->startAt), url);
+    }
+    std::shared_future<Body> result = request->promise.get_future().share();
+    RateLimiter::getInstance().recordRequest();
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (stopping)
+        {
+            throw NetworkError("Async fetcher is shutting down");
+        }
+        pending.push_back(std::move(request));
+    }
+    curl_multi_wakeup(multi);
+    return result;
+}
+
+void AsyncFetcher::run()
+{
+    Tracer::getInstance().nameThread("async fetcher");
+    while (true)
+    {
+        auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (stopping)
+            {
+                break;
+            }
+        }
+        startDueRequests(now);
+
+        int running = 0;
+        curl_multi_perform(multi, &running);
+
+        int queued = 0;
+        while (CURLMsg *msg = curl_multi_info_read(multi, &queued))
+        {
+            if (msg->msg == CURLMSG_DONE)
+            {
+                finishRequest(msg->easy_handle, msg->data.result);
+            }
+        }
+
+        int timeoutMs = nextWakeupMs(std::chrono::steady_clock::now());
+        curl_multi_poll(multi, nullptr, 0, timeoutMs, nullptr);
+    }
+
+    // Abort whatever is still queued or in flight
+    std::deque<std::unique_ptr<Request>> remaining;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        remaining.swap(pending);
+    }
+    for (Request *request : inFlight)
+    {
+        curl_multi_remove_handle(multi, request->handle->get());
+        remaining.emplace_back(request);
+    }
+    inFlight.clear();
+    for (auto &request : remaining)
+    {
+        settle(*request, std::make_exception_ptr(NetworkError("Request aborted: " + request->url)));
+    }
+}
+
+void AsyncFetcher::startDueRequests(std::chrono::steady_clock::time_point now)
+{
+    std::deque<std::unique_ptr<Request>> due;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        for (auto it = pending.begin(); it != pending.end();)
+        {
+            if ((*it)->startAt <= now)
+            {
+                due.push_back(std::move(*it));
+                it = pending.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    for (auto &request : due)
+    {
+        try
+        {
+            request->handle.emplace(ConnectionPool::getInstance().acquire(request->url));
+        }
+        catch (const NetworkError &)
+        {
+            settle(*request, std::current_exception());
+            continue;
+        }
+
+        CURL *curl = request->handle->get();
+        request->response = NetworkUtils::HttpResponse();
+        NetworkUtils::prepareTransfer(curl, request->url, request->response);
+        request->transferStartedAt = std::chrono::steady_clock::now();
+        curl_easy_setopt(curl, CURLOPT_PRIVATE, request.get());
+        curl_multi_add_handle(multi, curl);
+        inFlight.push_back(request.release());
+    }
+}
+
+void AsyncFetcher::finishRequest(CURL *curl, CURLcode result)
+{
+    Request *raw = nullptr;
+    curl_easy_getinfo(curl, CURLINFO_PRIVATE, &raw);
+    curl_multi_remove_handle(multi, curl);
+    inFlight.erase(std::find(inFlight.begin(), inFlight.end(), raw));
+
+    std::unique_ptr<Request> request(raw);
+    if (Tracer::enabled())
+    {
+        Tracer::getInstance().async("GET", "network", request->traceId, request->transferStartedAt,
+                                    std::chrono::steady_clock::now(), request->url);
+    }
+    std::exception_ptr error;
+    if (result != CURLE_OK)
+    {
+        error = std::make_exception_ptr(NetworkError("Failed to fetch page: " + std::string(curl_easy_strerror(result))));
+        Metrics::getInstance().recordFailure(request->url);
+    }
+    else
+    {
+        NetworkUtils::completeTransfer(curl, request->url, request->response);
+        long status = request->response.status;
+        LOG_DEBUG("GET {} -> {} in {} ms ({} bytes, async)", request->url, status, request->response.timing.totalMs,
+                  request->response.timing.bytes);
+        if (status >= 400)
+        {
+            error = std::make_exception_ptr(HttpError(status, request->response.retryAfter,
+                                                      "HTTP " + std::to_string(status) + " from " +
+                                                          ConnectionPool::hostFromUrl(request->url)));
+        }
+    }
+    request->handle.reset();
+
+    std::chrono::milliseconds delay;
+    if (error && NetworkUtils::planRetry(error, request->attempt++, request->maxRetries, request->retryDelay, delay))
+    {
+        Logger::getInstance().logRetryAttempt(request->url, request->attempt);
+        Metrics::getInstance().recordRetry(request->url);
+        auto now = std::chrono::steady_clock::now();
+        request->startAt = RateLimiter::getInstance().reserve(request->url, now + delay);
+        if (Tracer::enabled())
+        {
+            Tracer::getInstance().async("retry delay", "network", request->traceId, now, request->startAt, request->url);
+        }
+        std::lock_guard<std::mutex> lock(queueMutex);
+        pending.push_back(std::move(request));
+        return;
+    }
+    settle(*request, error);
+}
+
+void AsyncFetcher::settle(Request &request, std::exception_ptr error)
+{
+    if (Tracer::enabled())
+    {
+        Tracer::getInstance().async("fetchPageAsync", "network", request.traceId, request.queuedAt,
+                                    std::chrono::steady_clock::now(), request.url);
+    }
+    if (error)
+    {
+        request.promise.set_exception(error);
+    }
+    else
+    {
+        request.promise.set_value(std::make_shared<const std::string>(std::move(request.response.body)));
+    }
+    if (request.onDone)
+    {
+        request.onDone();
+    }
+}
+
+int AsyncFetcher::nextWakeupMs(std::chrono::steady_clock::time_point now)
+{
+    int timeoutMs = 1000;
+    std::lock_guard<std::mutex> lock(queueMutex);
+    for (const auto &request : pending)
+    {
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(request->startAt - now).count();
+        timeoutMs = std::min<int>(timeoutMs, static_cast<int>(std::max<long long>(0, wait)));
+    }
+    return timeoutMs;
+}
@@ -0,0 +1,233 @@
+#include "batch_runner.h"
+#include "persistent_cache.h"
+#include "tracer.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+BatchRunner::BatchRunner(SteamApiHelper &steamApi, bool steamApiAvailable, GameCache &gameCache, Scraper &scraper)
+    : steamApi(steamApi), steamApiAvailable(steamApiAvailable), gameCache(gameCache), scraper(scraper)
+{
+}
+
+BatchSummary BatchRunner::run(std::istream &input, int workers, bool ordered, const ResultCallback &onResult)
+{
+    auto start = std::chrono::steady_clock::now();
+    nextIndex = 0;
+    nextToEmit = 0;
+    reorderBuffer.clear();
+    summary = BatchSummary();
+    this->ordered = ordered;
+    callback = &onResult;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < std::max(1, workers); ++i)
+    {
+        threads.emplace_back(&BatchRunner::work, this, std::ref(input));
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    callback = nullptr;
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+}
+
+void BatchRunner::work(std::istream &input)
+{
+    Tracer::getInstance().nameThread("batch worker");
+    std::string line;
+    size_t index = 0;
+    while (nextLine(input, line, index))
+    {
+        BatchResult result = resolve(line);
+        result.index = index;
+        publish(std::move(result));
+    }
+}
+
+bool BatchRunner::nextLine(std::istream &input, std::string &line, size_t &index)
+{
+    std::lock_guard<std::mutex> lock(inputMutex);
+    while (std::getline(input, line))
+    {
+        // Trim surrounding whitespace (including the CR of CRLF files)
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos)
+        {
+            continue;
+        }
+        line = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+        index = nextIndex++;
+        return true;
+    }
+    return false;
+}
+
+void BatchRunner::publish(BatchResult result)
+{
+    std::unique_lock<std::mutex> lock(outputMutex);
+    switch (result.status)
+    {
+    case BatchResult::Status::Found:
+        ++summary.found;
+        break;
+    case BatchResult::Status::NotFound:
+        ++summary.notFound;
+        break;
+    case BatchResult::Status::Failed:
+        ++summary.failed;
+        break;
+    }
+    ++summary.total;
+
+    if (!ordered)
+    {
+        (*callback)(result);
+        return;
+    }
+
+    // Keep the reorder buffer bounded while an earlier line is still being resolved
+    outputReady.wait(lock, [&]
+                     { return result.index < nextToEmit + MAX_REORDER; });
+
+    size_t index = result.index;
+    reorderBuffer.emplace(index, std::move(result));
+    bool emitted = false;
+    for (auto it = reorderBuffer.begin(); it != reorderBuffer.end() && it->first == nextToEmit;
+         it = reorderBuffer.erase(it))
+    {
+        (*callback)(it->second);
+        ++nextToEmit;
+        emitted = true;
+    }
+    if (emitted)
+    {
+        outputReady.notify_all();
+    }
+}
+
+BatchResult BatchRunner::resolve(const std::string &input)
+{
+    TRACE_SCOPE("resolve", "batch", input);
+    BatchResult result;
+    result.input = input;
+
+    try
+    {
+        // Same lookup order as an interactive search: memory, disk, Steam API, scraper
+        if (std::shared_ptr<const GameData> cached = gameCache.getGame(input))
+        {
+            result.gameData = *cached;
+            result.status = BatchResult::Status::Found;
+            return result;
+        }
+        PersistentCache &persistentCache = PersistentCache::getInstance();
+        if (persistentCache.loadGame(input, result.gameData))
+        {
+            gameCache.addGame(input, result.gameData);
+            result.status = BatchResult::Status::Found;
+            return result;
+        }
+
+        if (steamApiAvailable)
+        {
+            try
+            {
+                bool isAppId = std::all_of(input.begin(), input.end(), [](unsigned char c)
+                                           { return std::isdigit(c) != 0; });
+                if (isAppId)
+                {
+                    result.steamInfo = steamApi.getGameInfo(input);
+                }
+                else
+                {
+                    std::vector<SteamGameInfo> matches = steamApi.searchGames(input);
+                    if (!matches.empty())
+                    {
+                        result.steamInfo = std::move(matches.front());
+                    }
+                }
+                if (!result.steamInfo.name.empty())
+                {
+                    result.fromSteamApi = true;
+                    result.status = BatchResult::Status::Found;
+                    return result;
+                }
+            }
+            catch (const std::exception &)
+            {
+                // Fall back to scraping below
+            }
+        }
+
+        result.gameData = scraper.searchGame(input);
+        if (result.gameData.name.empty())
+        {
+            result.status = BatchResult::Status::NotFound;
+            return result;
+        }
+        gameCache.addGame(input, result.gameData);
+        persistentCache.storeGame(input, result.gameData);
+        result.status = BatchResult::Status::Found;
+    }
+    catch (const std::exception &e)
+    {
+        result.status = BatchResult::Status::Failed;
+        result.error = e.what();
+    }
+    return result;
+}
+
+BatchSummary BatchRunner::runPrices(std::istream &input, const PriceCallback &onPrice)
+{
+    auto start = std::chrono::steady_clock::now();
+    nextIndex = 0;
+    summary = BatchSummary();
+
+    std::vector<std::string> lines;
+    auto priceChunk = [&]()
+    {
+        std::vector<std::string> appIds;
+        std::vector<size_t> lineOfApp;
+        for (size_t i = 0; i < lines.size(); ++i)
+        {
+            std::string appId = steamApi.findAppId(lines[i]);
+            if (!appId.empty())
+            {
+                appIds.push_back(std::move(appId));
+                lineOfApp.push_back(i);
+            }
+        }
+
+        std::vector<SteamSaleInfo> sales = steamApi.getSaleInfoBatch(appIds);
+        SteamSaleInfo missing{};
+        for (size_t i = 0, app = 0; i < lines.size(); ++i)
+        {
+            const SteamSaleInfo &sale = (app < lineOfApp.size() && lineOfApp[app] == i) ? sales[app++] : missing;
+            ++summary.total;
+            ++(!sale.error.empty() ? summary.failed : sale.name.empty() ? summary.notFound : summary.found);
+            onPrice(lines[i], sale);
+        }
+        lines.clear();
+    };
+
+    std::string line;
+    size_t index = 0;
+    while (nextLine(input, line, index))
+    {
+        lines.push_back(line);
+        if (lines.size() == PRICE_CHUNK)
+        {
+            priceChunk();
+        }
+    }
+    priceChunk();
+
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+}
@@ -0,0 +1,418 @@
+#include "catalog_index.h"
+#include "network_utils.h"
+#include "json_reader.h"
+#include "config.h"
+#include "tracer.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static const char FILE_MAGIC[4] = {'S', 'D', 'B', 'A'};
+
+// One app collected while downloading the catalog
+struct CatalogApp
+{
+    uint32_t appId = 0;
+    std::string key;
+    std::string name;
+};
+
+// Parse one page of ISteamApps/GetAppList or IStoreService/GetAppList
+static bool parseAppListPage(const std::string &body, std::vector<CatalogApp> &apps, bool &haveMore, uint32_t &lastAppId)
+{
+    TRACE_SCOPE("parseAppListPage", "parse");
+    JsonReader reader(body);
+    std::string_view key;
+    bool found = false;
+    if (!reader.beginObject())
+    {
+        return false;
+    }
+    while (reader.nextKey(key))
+    {
+        if ((key != "applist" && key != "response") || !reader.beginObject())
+        {
+            reader.skipValue();
+            continue;
+        }
+        while (reader.nextKey(key))
+        {
+            if (key == "apps" && reader.beginArray())
+            {
+                found = true;
+                while (reader.nextElement())
+                {
+                    if (!reader.beginObject())
+                    {
+                        reader.skipValue();
+                        continue;
+                    }
+                    CatalogApp app;
+                    std::string_view field;
+                    while (reader.nextKey(field))
+                    {
+                        if (field == "appid")
+                            app.appId = static_cast<uint32_t>(reader.readInteger());
+                        else if (field == "name")
+                            reader.readScalar(app.name);
+                        else
+                            reader.skipValue();
+                    }
+                    if (app.appId != 0 && !app.name.empty())
+                    {
+                        apps.push_back(std::move(app));
+                    }
+                }
+            }
+            else if (key == "have_more_results")
+                haveMore = reader.readBool();
+            else if (key == "last_appid")
+                lastAppId = static_cast<uint32_t>(reader.readInteger());
+            else
+                reader.skipValue();
+        }
+    }
+    return found;
+}
+
+static void appendU32(std::string &out, uint32_t value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+// Write a file through a synced temp file and rename it into place
+static bool writeFileAtomically(const std::string &path, const std::string &data)
+{
+    std::string tempPath = path + ".tmp";
+    FILE *out = std::fopen(tempPath.c_str(), "wb");
+    if (!out)
+    {
+        return false;
+    }
+    bool written = std::fwrite(data.data(), 1, data.size(), out) == data.size() && std::fflush(out) == 0;
+#ifdef _WIN32
+    written = written && _commit(_fileno(out)) == 0;
+#else
+    written = written && fsync(fileno(out)) == 0;
+#endif
+    written = (std::fclose(out) == 0) && written;
+
+    std::error_code ec;
+    if (written)
+    {
+        std::filesystem::rename(tempPath, path, ec);
+    }
+    if (!written || ec)
+    {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+CatalogIndex::CatalogIndex() : entries(nullptr), blob(nullptr), count(0), builtAt(0)
+{
+}
+
+CatalogIndex &CatalogIndex::getInstance()
+{
+    static CatalogIndex instance;
+    return instance;
+}
+
+bool CatalogIndex::load(const std::string &path, int maxAgeHours)
+{
+    int64_t now = static_cast<int64_t>(std::time(nullptr));
+    if (mappedFile.open(path) && attach() && (maxAgeHours <= 0 || now - builtAt < int64_t(maxAgeHours) * 3600))
+    {
+        return true;
+    }
+
+    // Release the stale mapping before the file gets replaced
+    {
+        std::lock_guard<std::mutex> lock(byIdMutex);
+        byId.clear();
+    }
+    mappedFile.close();
+    entries = nullptr;
+    blob = nullptr;
+    count = 0;
+
+    if (!download(path))
+    {
+        std::cerr << "Warning: Could not refresh the Steam app catalog" << std::endl;
+    }
+    return mappedFile.open(path) && attach();
+}
+
+bool CatalogIndex::isLoaded() const
+{
+    return entries != nullptr;
+}
+
+size_t CatalogIndex::size() const
+{
+    return count;
+}
+
+bool CatalogIndex::attach()
+{
+    std::string_view file = mappedFile.view();
+    if (file.size() < HEADER_SIZE || std::memcmp(file.data(), FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+    {
+        return false;
+    }
+
+    uint32_t version;
+    uint32_t appCount;
+    uint32_t blobSize;
+    std::memcpy(&version, file.data() + 4, sizeof(version));
+    std::memcpy(&builtAt, file.data() + 8, sizeof(builtAt));
+    std::memcpy(&appCount, file.data() + 16, sizeof(appCount));
+    std::memcpy(&blobSize, file.data() + 20, sizeof(blobSize));
+    if (version != FILE_VERSION || file.size() != HEADER_SIZE + size_t(appCount) * sizeof(Entry) + blobSize)
+    {
+        return false;
+    }
+
+    // Lookups trust the entry offsets, so a corrupted table is rejected here and rebuilt
+    const char *table = file.data() + HEADER_SIZE;
+    for (size_t i = 0; i < appCount; ++i)
+    {
+        Entry entry;
+        std::memcpy(&entry, table + i * sizeof(Entry), sizeof(Entry));
+        if (uint64_t(entry.keyOffset) + entry.keyLength > blobSize ||
+            uint64_t(entry.nameOffset) + entry.nameLength > blobSize)
+        {
+            return false;
+        }
+    }
+
+    entries = table;
+    blob = entries + size_t(appCount) * sizeof(Entry);
+    count = appCount;
+    return true;
+}
+
+CatalogIndex::Entry CatalogIndex::entryAt(size_t index) const
+{
+    Entry entry;
+    std::memcpy(&entry, entries + index * sizeof(Entry), sizeof(Entry));
+    return entry;
+}
+
+std::string_view CatalogIndex::keyAt(size_t index) const
+{
+    Entry entry = entryAt(index);
+    return std::string_view(blob + entry.keyOffset, entry.keyLength);
+}
+
+CatalogIndex::App CatalogIndex::at(size_t index) const
+{
+    Entry entry = entryAt(index);
+    return App{entry.appId, std::string_view(blob + entry.nameOffset, entry.nameLength)};
+}
+
+size_t CatalogIndex::lowerBound(std::string_view key) const
+{
+    size_t low = 0;
+    size_t high = count;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if (keyAt(mid) < key)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+std::vector<CatalogIndex::App> CatalogIndex::findExact(const std::string &name, size_t limit) const
+{
+    std::vector<App> results;
+    std::string key = normalize(name);
+    if (!isLoaded() || key.empty())
+    {
+        return results;
+    }
+    for (size_t i = lowerBound(key); i < count && results.size() < limit && keyAt(i) == key; ++i)
+    {
+        results.push_back(at(i));
+    }
+    return results;
+}
+
+std::string_view CatalogIndex::findName(uint32_t appId) const
+{
+    if (!isLoaded())
+    {
+        return std::string_view();
+    }
+
+    std::lock_guard<std::mutex> lock(byIdMutex);
+    if (byId.empty())
+    {
+        byId.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            byId.push_back((uint64_t(entryAt(i).appId) << 32) | i);
+        }
+        std::sort(byId.begin(), byId.end());
+    }
+
+    auto it = std::lower_bound(byId.begin(), byId.end(), uint64_t(appId) << 32);
+    if (it == byId.end() || (*it >> 32) != appId)
+    {
+        return std::string_view();
+    }
+    return at(static_cast<size_t>(*it & 0xFFFFFFFF)).name;
+}
+
+std::string CatalogIndex::normalize(std::string_view name)
+{
+    std::string key;
+    key.reserve(name.size());
+    bool pendingSpace = false;
+    for (size_t i = 0; i < name.size(); ++i)
+    {
+        unsigned char c = static_cast<unsigned char>(name[i]);
+        bool keep = std::isalnum(c) != 0;
+
+        if (c >= 0x80)
+        {
+            // Treat trademark, registered and copyright signs as separators
+            std::string_view rest = name.substr(i);
+            if (rest.compare(0, 3, "\xE2\x84\xA2") == 0 || rest.compare(0, 2, "\xC2\xAE") == 0 ||
+                rest.compare(0, 2, "\xC2\xA9") == 0)
+            {
+                i += (rest[0] == '\xE2') ? 2 : 1;
+                keep = false;
+            }
+            else
+            {
+                keep = true;
+            }
+        }
+
+        if (!keep)
+        {
+            pendingSpace = !key.empty();
+            continue;
+        }
+        if (pendingSpace)
+        {
+            key += ' ';
+            pendingSpace = false;
+        }
+        key += static_cast<char>(c < 0x80 ? std::tolower(c) : c);
+    }
+    return key;
+}
+
+bool CatalogIndex::download(const std::string &path)
+{
+    Config &config = Config::getInstance();
+    std::vector<CatalogApp> apps;
+
+    std::cerr << "Downloading Steam app catalog..." << std::endl;
+    try
+    {
+        // IStoreService pages through the catalog but needs an API key
+        if (config.hasSteamApiKey())
+        {
+            uint32_t lastAppId = 0;
+            bool haveMore = true;
+            while (haveMore)
+            {
+                haveMore = false;
+                std::string params = "include_games=true&include_dlc=true&include_software=true"
+                                     "&max_results=50000&last_appid=" +
+                                     std::to_string(lastAppId);
+                std::string body = NetworkUtils::fetchSteamApiData("/IStoreService/GetAppList/v1/", params);
+                if (!parseAppListPage(body, apps, haveMore, lastAppId))
+                {
+                    break;
+                }
+            }
+        }
+
+        // Fall back to the keyless ISteamApps list
+        if (apps.empty())
+        {
+            std::string baseUrl = config.get("STEAM_API_BASE_URL");
+            if (baseUrl.empty())
+            {
+                baseUrl = "https://api.steampowered.com";
+            }
+            bool haveMore = false;
+            uint32_t lastAppId = 0;
+            parseAppListPage(NetworkUtils::fetchPageWithRetry(baseUrl + "/ISteamApps/GetAppList/v2/"),
+                             apps, haveMore, lastAppId);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error downloading Steam app catalog: " << e.what() << std::endl;
+        return false;
+    }
+
+    if (apps.empty())
+    {
+        return false;
+    }
+
+    for (auto &app : apps)
+    {
+        app.key = normalize(app.name);
+    }
+    apps.erase(std::remove_if(apps.begin(), apps.end(), [](const CatalogApp &app)
+                              { return app.key.empty(); }),
+               apps.end());
+    std::sort(apps.begin(), apps.end(), [](const CatalogApp &a, const CatalogApp &b)
+              { return a.key != b.key ? a.key < b.key : a.appId < b.appId; });
+
+    // Serialize header, entry table and string blob
+    std::string entryTable;
+    std::string stringBlob;
+    entryTable.reserve(apps.size() * sizeof(Entry));
+    for (const auto &app : apps)
+    {
+        appendU32(entryTable, app.appId);
+        appendU32(entryTable, static_cast<uint32_t>(stringBlob.size()));
+        appendU32(entryTable, static_cast<uint32_t>(app.key.size()));
+        stringBlob += app.key;
+        appendU32(entryTable, static_cast<uint32_t>(stringBlob.size()));
+        appendU32(entryTable, static_cast<uint32_t>(app.name.size()));
+        stringBlob += app.name;
+    }
+
+    std::string file;
+    int64_t now = static_cast<int64_t>(std::time(nullptr));
+    file.reserve(HEADER_SIZE + entryTable.size() + stringBlob.size());
+    file.append(FILE_MAGIC, sizeof(FILE_MAGIC));
+    appendU32(file, FILE_VERSION);
+    file.append(reinterpret_cast<const char *>(&now), sizeof(now));
+    appendU32(file, static_cast<uint32_t>(apps.size()));
+    appendU32(file, static_cast<uint32_t>(stringBlob.size()));
+    file += entryTable;
+    file += stringBlob;
+
+    if (!writeFileAtomically(path, file))
+    {
+        std::cerr << "Error: Unable to write Steam app catalog: " << path << std::endl;
+        return false;
+    }
+    std::cerr << "Steam app catalog ready (" << apps.size() << " apps)." << std::endl;
+    return true;
+}
@@ -5,9 +5,19 @@
 #include <fstream>
 
 // Define the USAGE string
-const char *CliArguments::USAGE = "Usage: steamdb_cli [options] <game_name>\n"
+const char *CliArguments::USAGE = "Usage: steamdb_cli [options] [game_name | app_id]\n"
+                                  "With a game name or App ID, look it up once and exit; otherwise start the interactive menu.\n"
                                   "Options:\n"
-                                  "  -h, --help    Show this help message\n";
+                                  "  -h, --help          Show this help message\n"
+                                  "  --batch[=FILE]      Resolve one game name or App ID per line from FILE (or stdin if omitted or -)\n"
+                                  "  --workers=N         Number of concurrent batch lookups (default 4)\n"
+                                  "  --unordered         Print batch results as they complete instead of in input order\n"
+                                  "  --prices            Fetch only current prices, batching many apps per request (not with --workers)\n"
+                                  "  --sales[=N]         Print the current Steam sales (default 20) and exit\n"
+                                  "  --format=FORMAT     Output format for non-interactive runs: text (default), ndjson or csv\n"
+                                  "  --output=FILE       Write non-interactive results to FILE instead of stdout\n"
+                                  "  --stats             Print per-endpoint request counts and p50/p95/p99 latencies at exit\n"
+                                  "  --trace[=FILE]      Write a Chrome trace of requests, waits, parsing and cache lookups to FILE (default steamdb_trace.json)\n";
 
 // Save the search history to a file
 void CliArguments::saveSearchHistory(const std::vector<std::string> &searchHistory, const std::string &filename)
@@ -68,6 +78,33 @@ void CliArguments::parseArguments(int argc, char *argv[], std::string &gameName,
     }
 }
 
+// Check if an option was given, with or without a value
+bool CliArguments::hasOption(const std::vector<std::string> &options, const std::string &name)
+{
+    for (const auto &option : options)
+    {
+        if (option == name || option.compare(0, name.size() + 1, name + "=") == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Get the value of a "--name=value" option
+std::string CliArguments::getOptionValue(const std::vector<std::string> &options, const std::string &name,
+                                         const std::string &defaultValue)
+{
+    for (const auto &option : options)
+    {
+        if (option.compare(0, name.size() + 1, name + "=") == 0)
+        {
+            return option.substr(name.size() + 1);
+        }
+    }
+    return defaultValue;
+}
+
 // Display the user's Steam library
 void CliArguments::displaySteamLibrary()
 {
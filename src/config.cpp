@@ -36,6 +36,25 @@ std::string Config::get(const std::string &key) const
     return "";
 }
 
+// Get an integer value, warning about and ignoring one that does not parse
+long long Config::getInt(const std::string &key, long long defaultValue) const
+{
+    std::string value = get(key);
+    if (value.empty())
+    {
+        return defaultValue;
+    }
+    try
+    {
+        return std::stoll(value);
+    }
+    catch (const std::exception &)
+    {
+        std::cerr << "Warning: Invalid " << key << " value: " << value << std::endl;
+        return defaultValue;
+    }
+}
+
 // Set a configuration value by key
 void Config::set(const std::string &key, const std::string &value)
 {
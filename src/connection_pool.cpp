@@ -0,0 +1,144 @@
+#include "connection_pool.h"
+#include "error_handling.h"
+#include <algorithm>
+#include <cctype>
+
+ConnectionPool::Handle::Handle(ConnectionPool *pool, std::string host, CURL *curl)
+    : pool(pool), host(std::move(host)), curl(curl)
+{
+}
+
+ConnectionPool::Handle::Handle(Handle &&other) noexcept
+    : pool(other.pool), host(std::move(other.host)), curl(other.curl)
+{
+    other.curl = nullptr;
+}
+
+ConnectionPool::Handle::~Handle()
+{
+    if (curl)
+    {
+        pool->release(host, curl);
+    }
+}
+
+// Initialize libcurl once and create the share object
+ConnectionPool::ConnectionPool()
+{
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    share = curl_share_init();
+    if (share)
+    {
+        curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lockShare);
+        curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlockShare);
+        curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    }
+}
+
+// Clean up idle handles, the share object and libcurl
+ConnectionPool::~ConnectionPool()
+{
+    for (auto &entry : idleHandles)
+    {
+        for (CURL *curl : entry.second)
+        {
+            curl_easy_cleanup(curl);
+        }
+    }
+    idleHandles.clear();
+
+    if (share)
+    {
+        curl_share_cleanup(share);
+    }
+    curl_global_cleanup();
+}
+
+ConnectionPool &ConnectionPool::getInstance()
+{
+    static ConnectionPool instance;
+    return instance;
+}
+
+ConnectionPool::Handle ConnectionPool::acquire(const std::string &url)
+{
+    std::string host = hostFromUrl(url);
+    CURL *curl = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        auto it = idleHandles.find(host);
+        if (it != idleHandles.end() && !it->second.empty())
+        {
+            curl = it->second.back();
+            it->second.pop_back();
+        }
+    }
+
+    if (curl)
+    {
+        // Reset options but keep the handle's live connections
+        curl_easy_reset(curl);
+    }
+    else
+    {
+        curl = curl_easy_init();
+        if (!curl)
+        {
+            throw NetworkError("Failed to initialize CURL");
+        }
+    }
+
+    configureHandle(curl);
+    return Handle(this, std::move(host), curl);
+}
+
+void ConnectionPool::release(const std::string &host, CURL *curl)
+{
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        std::vector<CURL *> &idle = idleHandles[host];
+        if (idle.size() < MAX_IDLE_PER_HOST)
+        {
+            idle.push_back(curl);
+            return;
+        }
+    }
+    curl_easy_cleanup(curl);
+}
+
+void ConnectionPool::configureHandle(CURL *curl)
+{
+    if (share)
+    {
+        curl_easy_setopt(curl, CURLOPT_SHARE, share);
+    }
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, "SteamDB CLI/1.0");
+    // Offer every encoding this libcurl can decode; bodies are inflated as they stream in
+    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
+}
+
+std::string ConnectionPool::hostFromUrl(const std::string &url)
+{
+    size_t start = url.find("://");
+    start = (start == std::string::npos) ? 0 : start + 3;
+    size_t end = url.find_first_of("/?#", start);
+    std::string host = url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+    std::transform(host.begin(), host.end(), host.begin(), ::tolower);
+    return host;
+}
+
+void ConnectionPool::lockShare(CURL *, curl_lock_data data, curl_lock_access, void *userptr)
+{
+    static_cast<ConnectionPool *>(userptr)->shareLocks[data].lock();
+}
+
+void ConnectionPool::unlockShare(CURL *, curl_lock_data data, void *userptr)
+{
+    static_cast<ConnectionPool *>(userptr)->shareLocks[data].unlock();
+}
@@ -0,0 +1,160 @@
+#include "fuzzy_index.h"
+#include <algorithm>
+#include <cctype>
+
+// Weight of unmatched document trigrams relative to unmatched query trigrams.
+// Below 1 so a long title containing the whole query still ranks well.
+static const double EXTRA_GRAM_WEIGHT = 0.25;
+
+// Matches must cover at least this share of the query's trigrams
+static const double MIN_QUERY_COVERAGE = 0.4;
+
+// Matches scoring below this are treated as noise
+static const double MIN_SCORE = 0.3;
+
+void FuzzyIndex::extractGrams(std::string_view name, std::vector<uint32_t> &grams)
+{
+    std::string compact;
+    compact.reserve(name.size());
+    for (char c : name)
+    {
+        unsigned char uc = static_cast<unsigned char>(c);
+        if (std::isalnum(uc))
+        {
+            compact += static_cast<char>(std::tolower(uc));
+        }
+    }
+
+    grams.clear();
+    if (compact.empty())
+    {
+        return;
+    }
+    // Pad very short names so they still produce a single gram
+    while (compact.size() < 3)
+    {
+        compact += ' ';
+    }
+    for (size_t i = 0; i + 3 <= compact.size(); ++i)
+    {
+        grams.push_back((uint32_t(uint8_t(compact[i])) << 16) | (uint32_t(uint8_t(compact[i + 1])) << 8) |
+                        uint32_t(uint8_t(compact[i + 2])));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+}
+
+void FuzzyIndex::add(uint32_t appId, std::string_view name)
+{
+    static thread_local std::vector<uint32_t> nameGrams;
+    extractGrams(name, nameGrams);
+    if (nameGrams.empty())
+    {
+        return;
+    }
+
+    uint32_t documentId = static_cast<uint32_t>(documents.size());
+    documents.push_back(Document{appId, name, static_cast<uint16_t>(std::min<size_t>(nameGrams.size(), UINT16_MAX))});
+    for (uint32_t gram : nameGrams)
+    {
+        pairs.push_back((uint64_t(gram) << 32) | documentId);
+    }
+}
+
+void FuzzyIndex::build()
+{
+    std::sort(pairs.begin(), pairs.end());
+
+    grams.clear();
+    offsets.clear();
+    postings.clear();
+    postings.reserve(pairs.size());
+    for (uint64_t pair : pairs)
+    {
+        uint32_t gram = static_cast<uint32_t>(pair >> 32);
+        if (grams.empty() || grams.back() != gram)
+        {
+            grams.push_back(gram);
+            offsets.push_back(static_cast<uint32_t>(postings.size()));
+        }
+        postings.push_back(static_cast<uint32_t>(pair));
+    }
+    offsets.push_back(static_cast<uint32_t>(postings.size()));
+
+    pairs.clear();
+    pairs.shrink_to_fit();
+}
+
+size_t FuzzyIndex::size() const
+{
+    return documents.size();
+}
+
+std::vector<FuzzyIndex::Match> FuzzyIndex::search(const std::string &query, size_t limit) const
+{
+    std::vector<Match> matches;
+    std::vector<uint32_t> queryGrams;
+    extractGrams(query, queryGrams);
+    if (queryGrams.empty() || documents.empty())
+    {
+        return matches;
+    }
+
+    // Count shared trigrams per document, remembering which documents were touched
+    std::vector<uint16_t> shared(documents.size(), 0);
+    std::vector<uint32_t> touched;
+    for (uint32_t gram : queryGrams)
+    {
+        auto it = std::lower_bound(grams.begin(), grams.end(), gram);
+        if (it == grams.end() || *it != gram)
+        {
+            continue;
+        }
+        size_t slot = static_cast<size_t>(it - grams.begin());
+        for (uint32_t i = offsets[slot]; i < offsets[slot + 1]; ++i)
+        {
+            uint32_t documentId = postings[i];
+            if (shared[documentId]++ == 0)
+            {
+                touched.push_back(documentId);
+            }
+        }
+    }
+
+    // Score: shared / (query grams + weighted unmatched document grams)
+    double queryCount = static_cast<double>(queryGrams.size());
+    for (uint32_t documentId : touched)
+    {
+        double common = shared[documentId];
+        if (common < queryCount * MIN_QUERY_COVERAGE)
+        {
+            continue;
+        }
+        const Document &document = documents[documentId];
+        double extra = std::max(0.0, double(document.gramCount) - common);
+        double score = common / (queryCount + EXTRA_GRAM_WEIGHT * extra);
+        if (score >= MIN_SCORE)
+        {
+            matches.push_back(Match{document.appId, document.name, score});
+        }
+    }
+
+    auto better = [](const Match &a, const Match &b)
+    {
+        if (a.score != b.score)
+            return a.score > b.score;
+        if (a.name.size() != b.name.size())
+            return a.name.size() < b.name.size();
+        return a.appId < b.appId;
+    };
+    if (matches.size() > limit)
+    {
+        std::partial_sort(matches.begin(), matches.begin() + limit, matches.end(), better);
+        matches.resize(limit);
+    }
+    else
+    {
+        std::sort(matches.begin(), matches.end(), better);
+    }
+    return matches;
+}
@@ -1,21 +1,131 @@
 #include "game_cache.h"
+#include "tracer.h"
+#include <functional>
+#include <mutex>
+
+// Heap bytes held by a string beyond its inline buffer
+static size_t stringBytes(const std::string& value) {
+    return value.capacity() > 15 ? value.capacity() + 1 : 0;
+}
+
+GameCache::GameCache(size_t maxBytes) : maxBytes(maxBytes) {}
+
+size_t GameCache::estimateSize(const std::string& gameName, const GameData& data) {
+    // Node, shared_ptr control block and hash node overhead plus every heap-allocated string
+    size_t bytes = sizeof(Node) + sizeof(GameData) + 2 * sizeof(void*) + sizeof(std::string) + 6 * sizeof(void*);
+    bytes += 2 * stringBytes(gameName);
+    bytes += stringBytes(data.name) + stringBytes(data.appId) + stringBytes(data.currentPrice);
+    bytes += stringBytes(data.lowestPrice) + stringBytes(data.metacritic) + stringBytes(data.releaseDate);
+    bytes += stringBytes(data.description) + stringBytes(data.reviewScore);
+    bytes += data.tags.capacity() * sizeof(std::string);
+    for (const auto& tag : data.tags) {
+        bytes += stringBytes(tag);
+    }
+    return bytes;
+}
+
+GameCache::Shard& GameCache::shardFor(const std::string& gameName) {
+    return shards[std::hash<std::string>{}(gameName) % SHARD_COUNT];
+}
 
 bool GameCache::hasGame(const std::string& gameName) {
-    std::lock_guard<std::mutex> lock(cacheMutex);
-    return cache.find(gameName) != cache.end();
+    Shard& shard = shardFor(gameName);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.index.find(gameName) != shard.index.end();
 }
 
 void GameCache::addGame(const std::string& gameName, const GameData& data) {
-    std::lock_guard<std::mutex> lock(cacheMutex);
-    cache[gameName] = data;
+    size_t bytes = estimateSize(gameName, data);
+    size_t budget = maxBytes.load(std::memory_order_relaxed) / SHARD_COUNT;
+    if (bytes > budget) {
+        // Would evict the whole shard and still not fit; drop the old value rather than serve it
+        Shard& shard = shardFor(gameName);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.index.find(gameName);
+        if (it != shard.index.end()) {
+            shard.bytes -= it->second->bytes;
+            shard.clock.erase(it->second);
+            shard.index.erase(it);
+        }
+        return;
+    }
+
+    // Build the snapshot before taking the lock
+    auto snapshot = std::make_shared<const GameData>(data);
+
+    Shard& shard = shardFor(gameName);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.index.find(gameName);
+    if (it != shard.index.end()) {
+        Node& node = *it->second;
+        shard.bytes -= node.bytes;
+        node.data = std::move(snapshot);
+        node.bytes = bytes;
+        node.referenced.store(true, std::memory_order_relaxed);
+    } else {
+        shard.clock.emplace_back(gameName, std::move(snapshot), bytes);
+        shard.index.emplace(gameName, std::prev(shard.clock.end()));
+    }
+    shard.bytes += bytes;
+    evictToBudget(shard, budget);
+}
+
+std::shared_ptr<const GameData> GameCache::getGame(const std::string& gameName) {
+    TRACE_SCOPE("GameCache::getGame", "cache", gameName);
+    Shard& shard = shardFor(gameName);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.index.find(gameName);
+    if (it == shard.index.end()) {
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    shard.hits.fetch_add(1, std::memory_order_relaxed);
+    it->second->referenced.store(true, std::memory_order_relaxed);
+    return it->second->data;
+}
+
+void GameCache::setMaxBytes(size_t newMaxBytes) {
+    maxBytes.store(newMaxBytes, std::memory_order_relaxed);
+    for (Shard& shard : shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        evictToBudget(shard, newMaxBytes / SHARD_COUNT);
+    }
+}
+
+GameCache::Stats GameCache::getStats() {
+    Stats stats;
+    stats.maxBytes = maxBytes.load(std::memory_order_relaxed);
+    for (Shard& shard : shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        stats.hits += shard.hits.load(std::memory_order_relaxed);
+        stats.misses += shard.misses.load(std::memory_order_relaxed);
+        stats.evictions += shard.evictions.load(std::memory_order_relaxed);
+        stats.entries += shard.index.size();
+        stats.bytes += shard.bytes;
+    }
+    return stats;
 }
 
-GameData GameCache::getGame(const std::string& gameName) {
-    std::lock_guard<std::mutex> lock(cacheMutex);
-    return cache.at(gameName);
+void GameCache::evictToBudget(Shard& shard, size_t budget) {
+    while (shard.bytes > budget && !shard.clock.empty()) {
+        auto hand = shard.clock.begin();
+        if (hand->referenced.exchange(false, std::memory_order_relaxed)) {
+            // Second chance: move recently used entries behind the hand
+            shard.clock.splice(shard.clock.end(), shard.clock, hand);
+            continue;
+        }
+        shard.bytes -= hand->bytes;
+        shard.index.erase(hand->name);
+        shard.clock.erase(hand);
+        shard.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
 void GameCache::clear() {
-    std::lock_guard<std::mutex> lock(cacheMutex);
-    cache.clear();
-}
\ No newline at end of file
+    for (Shard& shard : shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.index.clear();
+        shard.clock.clear();
+        shard.bytes = 0;
+    }
+}
@@ -0,0 +1,149 @@
+#include "html_scanner.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define HTML_SCANNER_SSE2 1
+#endif
+
+namespace HtmlScanner
+{
+
+    Literal::Literal(std::string_view text) : text(text)
+    {
+    }
+
+    size_t Literal::findIn(std::string_view haystack, size_t from) const
+    {
+        size_t length = text.size();
+        if (length == 0)
+        {
+            return from <= haystack.size() ? from : std::string_view::npos;
+        }
+        if (from > haystack.size() || haystack.size() - from < length)
+        {
+            return std::string_view::npos;
+        }
+
+        const char *data = haystack.data();
+        size_t lastStart = haystack.size() - length;
+        size_t i = from;
+
+#ifdef HTML_SCANNER_SSE2
+        // Compare the first and last bytes of 16 candidate positions at once; only
+        // positions where both agree are verified with memcmp
+        if (length > 1)
+        {
+            const __m128i first = _mm_set1_epi8(text.front());
+            const __m128i last = _mm_set1_epi8(text.back());
+            for (; i + 16 <= lastStart + 1; i += 16)
+            {
+                __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+                __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + length - 1));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                    _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+                while (mask != 0)
+                {
+                    size_t candidate = i + static_cast<size_t>(__builtin_ctz(mask));
+                    if (std::memcmp(data + candidate + 1, text.data() + 1, length - 2) == 0)
+                    {
+                        return candidate;
+                    }
+                    mask &= mask - 1;
+                }
+            }
+        }
+#endif
+
+        while (i <= lastStart)
+        {
+            const void *hit = std::memchr(data + i, text.front(), lastStart - i + 1);
+            if (!hit)
+            {
+                break;
+            }
+            i = static_cast<size_t>(static_cast<const char *>(hit) - data);
+            if (std::memcmp(data + i + 1, text.data() + 1, length - 1) == 0)
+            {
+                return i;
+            }
+            ++i;
+        }
+        return std::string_view::npos;
+    }
+
+    Pattern::Pattern(std::initializer_list<Step> steps)
+    {
+        literals.reserve(steps.size());
+        bounds.reserve(steps.size());
+        for (const Step &step : steps)
+        {
+            literals.emplace_back(step.literal);
+            bounds.emplace_back(step.bound);
+            captures.push_back(step.capture);
+        }
+    }
+
+    bool Pattern::match(std::string_view text, size_t from, std::vector<std::string_view> &captured, size_t &end,
+                        size_t &anchor) const
+    {
+        for (anchor = literals.front().findIn(text, from); anchor != std::string_view::npos;
+             anchor = literals.front().findIn(text, anchor + 1))
+        {
+            captured.clear();
+            size_t cursor = anchor + literals.front().size();
+            bool rejected = false;
+            for (size_t i = 1; i < literals.size(); ++i)
+            {
+                // Look for the literal only up to the bound, so a missing one costs a short scan
+                size_t limit = bounds[i].size() > 0 ? bounds[i].findIn(text, cursor) : std::string_view::npos;
+                size_t found = literals[i].findIn(text.substr(0, limit), cursor);
+                if (found == std::string_view::npos)
+                {
+                    if (limit == std::string_view::npos)
+                    {
+                        return false; // Cut off; the caller retries from this anchor
+                    }
+                    rejected = true;
+                    break;
+                }
+                if (captures[i])
+                {
+                    captured.push_back(text.substr(cursor, found - cursor));
+                }
+                cursor = found + literals[i].size();
+            }
+            if (!rejected)
+            {
+                end = cursor;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Matcher::next(std::string_view text, std::vector<std::string_view> &captures)
+    {
+        size_t end = 0;
+        size_t anchor = 0;
+        if (pattern.match(text, position, captures, end, anchor))
+        {
+            position = end;
+            matchEnd = end;
+            return true;
+        }
+        if (anchor != std::string_view::npos)
+        {
+            // Retry from the anchor once more text has arrived
+            position = anchor;
+        }
+        else if (text.size() >= pattern.anchorSize())
+        {
+            // Keep enough of the tail to catch an anchor split across chunks
+            position = std::max(position, text.size() - pattern.anchorSize() + 1);
+        }
+        return false;
+    }
+
+}
@@ -0,0 +1,393 @@
+#include "json_reader.h"
+#include "error_handling.h"
+#include <cstring>
+
+JsonReader::JsonReader(std::string_view json) : json(json), pos(0)
+{
+}
+
+JsonReader::Type JsonReader::peek()
+{
+    skipWhitespace();
+    if (pos >= json.size())
+    {
+        return Type::End;
+    }
+
+    switch (json[pos])
+    {
+    case '{':
+        return Type::Object;
+    case '[':
+        return Type::Array;
+    case '"':
+        return Type::String;
+    case 't':
+    case 'f':
+        return Type::Bool;
+    case 'n':
+        return Type::Null;
+    default:
+        return Type::Number;
+    }
+}
+
+bool JsonReader::beginObject()
+{
+    if (peek() != Type::Object)
+    {
+        return false;
+    }
+    ++pos;
+    return true;
+}
+
+bool JsonReader::nextKey(std::string_view &key)
+{
+    skipWhitespace();
+    if (pos < json.size() && json[pos] == ',')
+    {
+        ++pos;
+        skipWhitespace();
+    }
+    if (pos >= json.size())
+    {
+        fail("unterminated object");
+    }
+    if (json[pos] == '}')
+    {
+        ++pos;
+        return false;
+    }
+    if (json[pos] != '"')
+    {
+        fail("expected object key");
+    }
+
+    // Keys are returned as raw views; Steam API keys never contain escapes
+    size_t start = pos + 1;
+    skipString();
+    key = json.substr(start, pos - start - 1);
+
+    skipWhitespace();
+    expect(':');
+    return true;
+}
+
+bool JsonReader::beginArray()
+{
+    if (peek() != Type::Array)
+    {
+        return false;
+    }
+    ++pos;
+    return true;
+}
+
+bool JsonReader::nextElement()
+{
+    skipWhitespace();
+    if (pos < json.size() && json[pos] == ',')
+    {
+        ++pos;
+        skipWhitespace();
+    }
+    if (pos >= json.size())
+    {
+        fail("unterminated array");
+    }
+    if (json[pos] == ']')
+    {
+        ++pos;
+        return false;
+    }
+    return true;
+}
+
+void JsonReader::readScalar(std::string &out)
+{
+    out.clear();
+    switch (peek())
+    {
+    case Type::String:
+        readString(out);
+        break;
+    case Type::Number:
+        out.assign(readNumber());
+        break;
+    case Type::Bool:
+        if (json[pos] == 't')
+        {
+            readLiteral("true");
+            out = "true";
+        }
+        else
+        {
+            readLiteral("false");
+            out = "false";
+        }
+        break;
+    case Type::End:
+        fail("unexpected end of input");
+    default:
+        skipValue();
+        break;
+    }
+}
+
+bool JsonReader::readBool()
+{
+    if (peek() == Type::Bool && json[pos] == 't')
+    {
+        readLiteral("true");
+        return true;
+    }
+    skipValue();
+    return false;
+}
+
+long long JsonReader::readInteger()
+{
+    std::string text;
+    readScalar(text);
+    try
+    {
+        return text.empty() ? 0 : std::stoll(text);
+    }
+    catch (const std::exception &)
+    {
+        return 0;
+    }
+}
+
+void JsonReader::skipValue()
+{
+    switch (peek())
+    {
+    case Type::String:
+        skipString();
+        return;
+    case Type::Number:
+        readNumber();
+        return;
+    case Type::Bool:
+        readLiteral(json[pos] == 't' ? "true" : "false");
+        return;
+    case Type::Null:
+        readLiteral("null");
+        return;
+    case Type::End:
+        fail("unexpected end of input");
+    default:
+        break;
+    }
+
+    // Containers: scan to the matching close bracket, stepping over strings
+    int depth = 0;
+    while (pos < json.size())
+    {
+        char c = json[pos];
+        if (c == '"')
+        {
+            skipString();
+            continue;
+        }
+        ++pos;
+        if (c == '{' || c == '[')
+        {
+            ++depth;
+        }
+        else if ((c == '}' || c == ']') && --depth == 0)
+        {
+            return;
+        }
+    }
+    fail("unterminated container");
+}
+
+void JsonReader::skipWhitespace()
+{
+    while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\n' || json[pos] == '\r' || json[pos] == '\t'))
+    {
+        ++pos;
+    }
+}
+
+void JsonReader::expect(char c)
+{
+    if (pos >= json.size() || json[pos] != c)
+    {
+        fail("unexpected character");
+    }
+    ++pos;
+}
+
+// Append a code point to out as UTF-8
+static void appendUtf8(std::string &out, unsigned long cp)
+{
+    if (cp < 0x80)
+    {
+        out += static_cast<char>(cp);
+    }
+    else if (cp < 0x800)
+    {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000)
+    {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else
+    {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// Parse four hex digits; returns -1 on malformed input
+static long parseHex4(std::string_view text)
+{
+    if (text.size() < 4)
+    {
+        return -1;
+    }
+    long value = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        char c = text[i];
+        value <<= 4;
+        if (c >= '0' && c <= '9')
+            value |= c - '0';
+        else if (c >= 'a' && c <= 'f')
+            value |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            value |= c - 'A' + 10;
+        else
+            return -1;
+    }
+    return value;
+}
+
+void JsonReader::readString(std::string &out)
+{
+    expect('"');
+    while (true)
+    {
+        // Copy the run up to the next quote or escape in one go
+        size_t stop = json.find_first_of("\"\\", pos);
+        if (stop == std::string_view::npos)
+        {
+            fail("unterminated string");
+        }
+        out.append(json.data() + pos, stop - pos);
+        pos = stop + 1;
+        if (json[stop] == '"')
+        {
+            return;
+        }
+
+        if (pos >= json.size())
+        {
+            fail("unterminated escape");
+        }
+        char esc = json[pos++];
+        switch (esc)
+        {
+        case '"':
+        case '\\':
+        case '/':
+            out += esc;
+            break;
+        case 'b':
+            out += '\b';
+            break;
+        case 'f':
+            out += '\f';
+            break;
+        case 'n':
+            out += '\n';
+            break;
+        case 'r':
+            out += '\r';
+            break;
+        case 't':
+            out += '\t';
+            break;
+        case 'u':
+        {
+            long cp = parseHex4(json.substr(pos));
+            if (cp < 0)
+            {
+                fail("invalid unicode escape");
+            }
+            pos += 4;
+            // Combine UTF-16 surrogate pairs
+            if (cp >= 0xD800 && cp <= 0xDBFF && json.substr(pos, 2) == "\\u")
+            {
+                long low = parseHex4(json.substr(pos + 2));
+                if (low >= 0xDC00 && low <= 0xDFFF)
+                {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    pos += 6;
+                }
+            }
+            appendUtf8(out, static_cast<unsigned long>(cp));
+            break;
+        }
+        default:
+            fail("invalid escape");
+        }
+    }
+}
+
+void JsonReader::skipString()
+{
+    expect('"');
+    while (true)
+    {
+        size_t stop = json.find_first_of("\"\\", pos);
+        if (stop == std::string_view::npos)
+        {
+            fail("unterminated string");
+        }
+        pos = stop + 1;
+        if (json[stop] == '"')
+        {
+            return;
+        }
+        ++pos; // Skip the escaped character
+    }
+}
+
+std::string_view JsonReader::readNumber()
+{
+    size_t start = pos;
+    while (pos < json.size() && std::strchr("+-0123456789.eE", json[pos]) && json[pos] != '\0')
+    {
+        ++pos;
+    }
+    if (pos == start)
+    {
+        fail("unexpected character");
+    }
+    return json.substr(start, pos - start);
+}
+
+void JsonReader::readLiteral(std::string_view literal)
+{
+    if (json.substr(pos, literal.size()) != literal)
+    {
+        fail("invalid literal");
+    }
+    pos += literal.size();
+}
+
+void JsonReader::fail(const char *what) const
+{
+    throw ParsingError("Malformed JSON (" + std::string(what) + ") at offset " + std::to_string(pos));
+}
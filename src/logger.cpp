@@ -1,60 +1,418 @@
 #include "logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+#include <zlib.h>
+
+static const size_t TIMESTAMP_LENGTH = 19; // "YYYY-MM-DD HH:MM:SS"
+
+// Gzip a file next to it; the target is removed again if anything fails
+static bool gzipFile(const std::string& source, const std::string& target) {
+    std::ifstream in(source, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    gzFile out = gzopen(target.c_str(), "wb6");
+    if (!out) {
+        return false;
+    }
+    std::vector<char> buffer(64 * 1024);
+    bool written = true;
+    while (written && in) {
+        in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        std::streamsize count = in.gcount();
+        if (count > 0 && gzwrite(out, buffer.data(), static_cast<unsigned>(count)) != count) {
+            written = false;
+        }
+    }
+    written = (gzclose(out) == Z_OK) && written && !in.bad();
+    if (!written) {
+        std::remove(target.c_str());
+    }
+    return written;
+}
+
+Logger::Logger()
+    : fileBytes(0), rotateRetryBytes(0), compressorStopping(false), ring(new Slot[RING_SLOTS]), enqueuePos(0), dequeuePos(0), dropped(0),
+      running(false), minLevel(static_cast<int>(LogLevel::Off)) {
+    for (size_t i = 0; i < RING_SLOTS; ++i) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+        running.store(false, std::memory_order_release);
+        minLevel.store(static_cast<int>(LogLevel::Off), std::memory_order_relaxed);
+    }
+    wakeWriter.notify_one();
+    if (writer.joinable()) {
+        writer.join();
+    }
+
+    // Let the compressor finish the segments already queued
+    {
+        std::lock_guard<std::mutex> lock(compressMutex);
+        compressorStopping = true;
+    }
+    wakeCompressor.notify_one();
+    if (compressor.joinable()) {
+        compressor.join();
+    }
+}
+
+Logger& Logger::getInstance() {
+    static Logger instance;
+    return instance;
+}
 
 // Initialize the logger with a file name
-void Logger::init(const std::string& filename) {
+void Logger::init(const std::string& filename, LogLevel level, const LogRotation& rotation) {
     std::lock_guard<std::mutex> lock(logMutex);
-    logFile.open(filename, std::ios::out | std::ios::app);
-    if (!logFile.is_open()) {
+    if (running.load(std::memory_order_acquire)) {
+        throw std::runtime_error("Logger already initialized");
+    }
+    logPath = filename;
+    this->rotation = rotation;
+    if (!openFile()) {
         throw std::runtime_error("Failed to open log file: " + filename);
     }
+    // A file left by earlier runs may already be over its limits
+    rotateIfDue();
+    running.store(true, std::memory_order_release);
+    writer = std::thread(&Logger::run, this);
+    setLevel(level);
+}
+
+LogLevel Logger::parseLevel(const std::string& name, LogLevel fallback) {
+    std::string upper = name;
+    std::transform(upper.begin(), upper.end(), upper.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    if (upper == "DEBUG") return LogLevel::Debug;
+    if (upper == "INFO") return LogLevel::Info;
+    if (upper == "WARNING" || upper == "WARN") return LogLevel::Warning;
+    if (upper == "ERROR") return LogLevel::Error;
+    if (upper == "OFF" || upper == "NONE") return LogLevel::Off;
+    if (!name.empty()) {
+        std::cerr << "Warning: Invalid LOG_LEVEL value: " << name << std::endl;
+    }
+    return fallback;
+}
+
+const char* Logger::levelName(LogLevel level) {
+    switch (level) {
+    case LogLevel::Debug: return "DEBUG";
+    case LogLevel::Info: return "INFO";
+    case LogLevel::Warning: return "WARNING";
+    case LogLevel::Error: return "ERROR";
+    default: return "OFF";
+    }
 }
 
 // Log an info message
 void Logger::info(const std::string& message) {
-    log("INFO", message);
+    write(LogLevel::Info, "{}", message);
 }
 
 // Log a warning message
 void Logger::warning(const std::string& message) {
-    log("WARNING", message);
+    write(LogLevel::Warning, "{}", message);
 }
 
 // Log an error message
 void Logger::error(const std::string& message, const std::string& functionName, const std::string& fileName, int lineNumber) {
-    std::ostringstream oss;
-    oss << message << " [Function: " << functionName << ", File: " << fileName << ", Line: " << lineNumber << "]";
-    log("ERROR", oss.str());
+    write(LogLevel::Error, "{} [Function: {}, File: {}, Line: {}]", message, functionName, fileName, lineNumber);
 }
 
 // Log a debug message
 void Logger::debug(const std::string& message) {
-    log("DEBUG", message);
+    write(LogLevel::Debug, "{}", message);
 }
 
 // Log a retry attempt for a failed network request
 void Logger::logRetryAttempt(const std::string& url, int attemptNumber) {
-    std::ostringstream oss;
-    oss << "Retry attempt " << attemptNumber << " for URL: " << url;
-    log("RETRY", oss.str());
+    if (!isEnabled(LogLevel::Info)) {
+        return;
+    }
+    char message[MAX_RECORD];
+    size_t length = LogFormat::format(message, sizeof(message), "Retry attempt {} for URL: {}", attemptNumber, url);
+    log(LogLevel::Info, "RETRY", std::string_view(message, length));
 }
 
 // Log a message with a specific level
-void Logger::log(const std::string& level, const std::string& message) {
-    std::lock_guard<std::mutex> lock(logMutex);
-    if (logFile.is_open()) {
-        logFile << "[" << getCurrentTimestamp() << "] [" << level << "] " << message << std::endl;
-    } else {
-        throw std::runtime_error("Log file is not open");
+void Logger::log(LogLevel level, const char* label, std::string_view message) {
+    if (!isEnabled(level) || !running.load(std::memory_order_acquire)) {
+        return;
+    }
+    if (!push(label, message)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Bounded MPMC queue after Dmitry Vyukov, used here with a single consumer
+bool Logger::push(const char* level, std::string_view message) {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &ring[pos & (RING_SLOTS - 1)];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // "[timestamp] [LEVEL] message\n", truncated to the slot
+    char* out = slot->text;
+    size_t levelLength = std::strlen(level);
+    *out++ = '[';
+    formatTimestamp(out);
+    out += TIMESTAMP_LENGTH;
+    *out++ = ']';
+    *out++ = ' ';
+    *out++ = '[';
+    std::memcpy(out, level, levelLength);
+    out += levelLength;
+    *out++ = ']';
+    *out++ = ' ';
+    size_t room = MAX_RECORD - static_cast<size_t>(out - slot->text) - 1;
+    size_t length = std::min(message.size(), room);
+    std::memcpy(out, message.data(), length);
+    out += length;
+    *out++ = '\n';
+    slot->length = static_cast<size_t>(out - slot->text);
+
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    if ((pos & (RING_SLOTS / 2 - 1)) == 0) {
+        wakeWriter.notify_one();
+    }
+    return true;
+}
+
+size_t Logger::drain() {
+    size_t written = 0;
+    while (true) {
+        Slot& slot = ring[dequeuePos & (RING_SLOTS - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+            break;
+        }
+        logFile.write(slot.text, static_cast<std::streamsize>(slot.length));
+        fileBytes += slot.length;
+        slot.sequence.store(dequeuePos + RING_SLOTS, std::memory_order_release);
+        ++dequeuePos;
+        ++written;
+    }
+    return written;
+}
+
+void Logger::run() {
+    while (true) {
+        bool stopping = !running.load(std::memory_order_acquire);
+        size_t written = drain();
+
+        uint64_t lost = dropped.exchange(0, std::memory_order_relaxed);
+        if (lost > 0) {
+            char timestamp[TIMESTAMP_LENGTH];
+            char line[MAX_RECORD];
+            formatTimestamp(timestamp);
+            size_t length = LogFormat::format(line, sizeof(line), "[{}] [WARNING] {} log record(s) dropped, log buffer full\n",
+                                              std::string_view(timestamp, TIMESTAMP_LENGTH), lost);
+            logFile.write(line, static_cast<std::streamsize>(length));
+            fileBytes += length;
+        }
+        if (written > 0 || lost > 0) {
+            logFile.flush();
+        }
+        if (stopping) {
+            break;
+        }
+
+        rotateIfDue();
+
+        std::unique_lock<std::mutex> lock(logMutex);
+        wakeWriter.wait_for(lock, FLUSH_INTERVAL);
+    }
+}
+
+bool Logger::openFile() {
+    logFile.open(logPath, std::ios::out | std::ios::app);
+    if (!logFile.is_open()) {
+        return false;
+    }
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(logPath, ec);
+    fileBytes = ec ? 0 : static_cast<uint64_t>(size);
+
+    // The file is as old as its first record, "[YYYY-MM-DD HH:MM:SS] ...", which may
+    // have been written by an earlier run; an empty or unreadable file starts now
+    fileStartedAt = std::chrono::system_clock::now();
+    std::ifstream existing(logPath);
+    std::tm first{};
+    if (fileBytes > 0 && existing.get() == '[' && existing >> std::get_time(&first, "%Y-%m-%d %H:%M:%S")) {
+        first.tm_isdst = -1;
+        std::time_t started = std::mktime(&first);
+        if (started != -1) {
+            fileStartedAt = std::min(fileStartedAt, std::chrono::system_clock::from_time_t(started));
+        }
+    }
+    return true;
+}
+
+void Logger::rotateIfDue() {
+    if (fileBytes == 0) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    bool tooBig = rotation.maxBytes > 0 && fileBytes >= rotation.maxBytes;
+    bool tooOld = rotation.maxAge.count() > 0 && std::chrono::system_clock::now() - fileStartedAt >= rotation.maxAge;
+    bool backingOff = now < rotateRetryAt && fileBytes < rotateRetryBytes;
+    if ((tooBig || tooOld) && !backingOff && !rotate()) {
+        // Keep appending to the old file rather than retrying the rename on every wakeup
+        rotateRetryAt = now + ROTATE_RETRY_INTERVAL;
+        rotateRetryBytes = rotation.maxBytes > 0 ? fileBytes + rotation.maxBytes : UINT64_MAX;
+    }
+}
+
+bool Logger::rotate() {
+    namespace fs = std::filesystem;
+    fs::path active(logPath);
+
+    // <stem>.<YYYYMMDD-HHMMSS>[-N]<extension>, e.g. steamdb_cli.20240101-120000.log
+    std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm local;
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &local);
+    std::string base = (active.parent_path() / active.stem()).string() + "." + stamp;
+    std::string segment = base + active.extension().string();
+    std::error_code ec;
+    for (int suffix = 1; fs::exists(segment, ec) || fs::exists(segment + ".gz", ec); ++suffix) {
+        segment = base + "-" + std::to_string(suffix) + active.extension().string();
+    }
+
+    logFile.close();
+    fs::rename(active, segment, ec);
+    if (!openFile()) {
+        std::cerr << "Warning: Could not reopen log file " << logPath << " after rotation" << std::endl;
+    }
+    if (ec) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(compressMutex);
+        segments.push_back(segment);
+    }
+    if (!compressor.joinable()) {
+        compressor = std::thread(&Logger::compressSegments, this);
+    }
+    wakeCompressor.notify_one();
+    return true;
+}
+
+void Logger::compressSegments() {
+    while (true) {
+        std::string segment;
+        {
+            std::unique_lock<std::mutex> lock(compressMutex);
+            wakeCompressor.wait(lock, [this] { return compressorStopping || !segments.empty(); });
+            if (segments.empty()) {
+                return;
+            }
+            segment = std::move(segments.front());
+            segments.pop_front();
+        }
+        if (gzipFile(segment, segment + ".gz")) {
+            std::remove(segment.c_str());
+        }
+        enforceRetention();
+    }
+}
+
+void Logger::enforceRetention() {
+    namespace fs = std::filesystem;
+    if (rotation.maxTotalBytes == 0) {
+        return;
+    }
+
+    fs::path active(logPath);
+    fs::path directory = active.has_parent_path() ? active.parent_path() : fs::path(".");
+    std::string prefix = active.stem().string() + ".";
+    std::string extension = active.extension().string();
+    std::error_code ec;
+
+    struct Segment {
+        fs::path path;
+        fs::file_time_type modified;
+        uintmax_t size;
+    };
+    std::vector<Segment> rotated;
+    uintmax_t total = fs::file_size(active, ec);
+    if (ec) {
+        total = 0;
+    }
+    for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        std::string name = it->path().filename().string();
+        auto endsWith = [&name](const std::string& suffix) {
+            return name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+        };
+        bool isSegment = name != active.filename().string() && name.compare(0, prefix.size(), prefix) == 0 &&
+                         (endsWith(extension) || endsWith(extension + ".gz"));
+        std::error_code statError;
+        if (!isSegment || !it->is_regular_file(statError)) {
+            continue;
+        }
+        Segment segment{it->path(), it->last_write_time(statError), it->file_size(statError)};
+        if (!statError) {
+            rotated.push_back(segment);
+            total += segment.size;
+        }
+    }
+
+    // Oldest first
+    std::sort(rotated.begin(), rotated.end(), [](const Segment& a, const Segment& b) { return a.modified < b.modified; });
+    for (const Segment& segment : rotated) {
+        if (total <= rotation.maxTotalBytes) {
+            break;
+        }
+        if (fs::remove(segment.path, ec)) {
+            total -= segment.size;
+        }
     }
 }
 
 // Get the current timestamp
-std::string Logger::getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto now_c = std::chrono::system_clock::to_time_t(now);
-    std::ostringstream oss;
-    oss << std::put_time(std::localtime(&now_c), "%Y-%m-%d %H:%M:%S");
-    return oss.str();
+void Logger::formatTimestamp(char* out) {
+    struct CachedSecond {
+        std::time_t second = -1;
+        char text[TIMESTAMP_LENGTH + 1];
+    };
+    static thread_local CachedSecond cached;
+
+    std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    if (now != cached.second) {
+        std::tm local;
+#ifdef _WIN32
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        std::strftime(cached.text, sizeof(cached.text), "%Y-%m-%d %H:%M:%S", &local);
+        cached.second = now;
+    }
+    std::memcpy(out, cached.text, TIMESTAMP_LENGTH);
 }
 
 // Get the stack trace - Windows compatible version
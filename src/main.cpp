@@ -1,18 +1,24 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <ctime>
 #include <cstdlib>
-#include <thread>
 #include <chrono>
 #include <fstream>
 #include "scraper.h"
 #include "logger.h"
+#include "metrics.h"
+#include "tracer.h"
 #include "game_cache.h"
+#include "persistent_cache.h"
 #include "config.h"
 #include "steam_api_helper.h"
 #include <iomanip>
+#include <sstream>
 #include "cli_arguments.h"
+#include "batch_runner.h"
+#include "output_sink.h"
 
 // Large scale ASCII header title
 void printHeader()
@@ -105,6 +111,54 @@ void displayProgressBar(int progress, int total)
     std::cout.flush();
 }
 
+// Draws real transfer progress for interactive lookups and reports where the time went
+class ConsoleProgress : public NetworkUtils::ProgressListener
+{
+public:
+    void onProgress(const std::string &host, curl_off_t received, curl_off_t total) override
+    {
+        // curl reports progress very often; redraw at most every 50 ms
+        auto now = std::chrono::steady_clock::now();
+        if (received == 0 || (now - lastDraw < std::chrono::milliseconds(50) && received != total))
+        {
+            return;
+        }
+        lastDraw = now;
+        if (total > 0)
+        {
+            displayProgressBar(static_cast<int>(received * 1000 / total), 1000);
+        }
+        else
+        {
+            std::ostringstream line;
+            line << host << ": " << std::fixed << std::setprecision(1) << received / 1024.0 << " KB received\r";
+            std::cout << line.str() << std::flush;
+        }
+    }
+
+    void onComplete(const std::string &host, const NetworkUtils::TransferTiming &timing) override
+    {
+        // Clear the progress bar line, then summarize the transfer
+        std::ostringstream line;
+        line << "\33[2K" << host << ": " << std::fixed << std::setprecision(1) << timing.bytes / 1024.0 << " KB";
+        if (timing.decodedBytes > timing.bytes)
+        {
+            line << " (" << timing.decodedBytes / 1024.0 << " KB decoded)";
+        }
+        line << " in " << std::setprecision(0) << timing.totalMs << " ms (DNS " << timing.dnsMs
+             << " ms, connect " << timing.connectMs << " ms";
+        if (timing.tlsMs > 0)
+        {
+            line << ", TLS " << timing.tlsMs << " ms";
+        }
+        line << ", first byte " << timing.firstByteMs << " ms)";
+        std::cout << line.str() << std::endl;
+    }
+
+private:
+    std::chrono::steady_clock::time_point lastDraw;
+};
+
 // Function to display Steam sale information
 void displaySaleInfo(const SteamSaleInfo &saleInfo, int index)
 {
@@ -202,15 +256,226 @@ void displaySteamGameInfo(const SteamGameInfo &gameInfo)
               << std::endl;
 }
 
+// Print one batch result in the same layout as an interactive lookup
+void displayBatchResult(const BatchResult &result)
+{
+    switch (result.status)
+    {
+    case BatchResult::Status::Found:
+        if (result.fromSteamApi)
+        {
+            displaySteamGameInfo(result.steamInfo);
+        }
+        else
+        {
+            displayGameInfo(result.gameData);
+            std::cout << std::endl;
+        }
+        break;
+    case BatchResult::Status::NotFound:
+        std::cout << "No games found for: " << result.input << "\n"
+                  << std::endl;
+        break;
+    case BatchResult::Status::Failed:
+        std::cerr << "Error resolving " << result.input << ": " << result.error << std::endl;
+        break;
+    }
+}
+
+// Resolve a --batch list, or the game name given on the command line
+int runBatch(BatchRunner &runner, const std::string &gameName, const std::vector<std::string> &options, OutputSink *sink)
+{
+    bool batchMode = CliArguments::hasOption(options, "--batch");
+    std::string batchFile = CliArguments::getOptionValue(options, "--batch", "-");
+
+    int workers = 4;
+    try
+    {
+        workers = std::stoi(CliArguments::getOptionValue(options, "--workers", "4"));
+    }
+    catch (const std::exception &)
+    {
+        std::cerr << "Error: --workers expects a number" << std::endl;
+        return 2;
+    }
+    workers = std::max(1, std::min(workers, 64));
+
+    std::ifstream file;
+    std::istringstream single(gameName);
+    std::istream *input = &single;
+    if (batchMode && batchFile != "-")
+    {
+        file.open(batchFile);
+        if (!file)
+        {
+            std::cerr << "Error: Unable to open batch file: " << batchFile << std::endl;
+            return 2;
+        }
+        input = &file;
+    }
+    else if (batchMode)
+    {
+        input = &std::cin;
+    }
+
+    BatchSummary summary;
+    if (CliArguments::hasOption(options, "--prices"))
+    {
+        if (CliArguments::hasOption(options, "--workers"))
+        {
+            std::cerr << "Error: --workers cannot be combined with --prices (prices are batched into shared requests)" << std::endl;
+            return 2;
+        }
+        size_t listed = 0;
+        summary = runner.runPrices(*input, [sink, &listed](const std::string &line, const SteamSaleInfo &sale)
+                                   {
+            if (!sale.error.empty())
+                std::cerr << "Error pricing " << line << ": " << sale.error << std::endl;
+            else if (sale.name.empty())
+                std::cerr << "No price found for: " << line << std::endl;
+            else if (sink)
+                sink->write(sale);
+            else
+                displaySaleInfo(sale, static_cast<int>(++listed)); });
+    }
+    else
+    {
+        bool ordered = !CliArguments::hasOption(options, "--unordered");
+        BatchRunner::ResultCallback onResult = displayBatchResult;
+        if (sink)
+        {
+            onResult = [sink](const BatchResult &result)
+            { sink->write(result); };
+        }
+        summary = runner.run(*input, batchMode ? workers : 1, ordered, onResult);
+    }
+
+    if (batchMode)
+    {
+        double rate = summary.seconds > 0 ? summary.total / summary.seconds : 0.0;
+        std::cerr << "Resolved " << summary.total << " item(s) in " << std::fixed << std::setprecision(2)
+                  << summary.seconds << " s (" << rate << "/s): " << summary.found << " found, "
+                  << summary.notFound << " not found, " << summary.failed << " failed" << std::endl;
+        NetworkUtils::TransferTotals totals = NetworkUtils::transferTotals();
+        std::cerr << "Transferred " << totals.wireBytes / 1024.0 << " KB in " << totals.transfers << " request(s) ("
+                  << totals.decodedBytes / 1024.0 << " KB decoded)" << std::endl;
+        LOG_INFO("Batch run: {} items, {} failed", summary.total, summary.failed);
+    }
+    return summary.failed == 0 ? 0 : 1;
+}
+
+// Export the current Steam sales for --sales[=N]
+int exportSales(SteamApiHelper &steamApi, bool steamApiAvailable, const std::vector<std::string> &options, OutputSink *sink, Logger &logger)
+{
+    if (!steamApiAvailable)
+    {
+        std::cerr << "Steam API not available. Cannot fetch sales information." << std::endl;
+        return 1;
+    }
+
+    int limit = 20;
+    try
+    {
+        limit = std::stoi(CliArguments::getOptionValue(options, "--sales", "20"));
+    }
+    catch (const std::exception &)
+    {
+        std::cerr << "Error: --sales expects a number" << std::endl;
+        return 2;
+    }
+
+    try
+    {
+        std::vector<SteamSaleInfo> sales = steamApi.getCurrentSales(limit);
+        for (size_t i = 0; i < sales.size(); ++i)
+        {
+            if (sink)
+                sink->write(sales[i]);
+            else
+                displaySaleInfo(sales[i], i + 1);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error fetching sales: " << e.what() << std::endl;
+        logger.error("Error fetching current sales", __FUNCTION__, __FILE__, __LINE__);
+        return 1;
+    }
+    return 0;
+}
+
+// Run without the interactive menu, writing results in the --format chosen to stdout or --output
+int runNonInteractive(SteamApiHelper &steamApi, bool steamApiAvailable, BatchRunner &runner, const std::string &gameName,
+                      const std::vector<std::string> &options, Logger &logger)
+{
+    std::string format = CliArguments::getOptionValue(options, "--format", "text");
+    std::string outputPath = CliArguments::getOptionValue(options, "--output");
+    if (format != "text" && format != "ndjson" && format != "csv")
+    {
+        std::cerr << "Error: Unknown output format: " << format << " (expected text, ndjson or csv)" << std::endl;
+        return 2;
+    }
+
+    std::FILE *outFile = stdout;
+    std::ofstream textFile;
+    std::streambuf *coutBuffer = std::cout.rdbuf();
+    if (!outputPath.empty())
+    {
+        if (format == "text")
+        {
+            textFile.open(outputPath);
+            if (textFile)
+                std::cout.rdbuf(textFile.rdbuf());
+        }
+        else
+        {
+            outFile = std::fopen(outputPath.c_str(), "wb");
+        }
+        if (!outFile || (format == "text" && !textFile))
+        {
+            std::cerr << "Error: Unable to open output file: " << outputPath << std::endl;
+            return 2;
+        }
+    }
+
+    std::unique_ptr<OutputSink> sink = OutputSink::create(format, outFile);
+    int exitCode = CliArguments::hasOption(options, "--sales")
+                       ? exportSales(steamApi, steamApiAvailable, options, sink.get(), logger)
+                       : runBatch(runner, gameName, options, sink.get());
+
+    sink.reset();
+    std::cout.flush();
+    std::cout.rdbuf(coutBuffer);
+    if (outFile != stdout)
+    {
+        std::fclose(outFile);
+    }
+    return exitCode;
+}
+
+// Save the spans recorded for --trace
+void writeTrace(const std::vector<std::string> &options)
+{
+    if (Tracer::enabled() && !Tracer::getInstance().write())
+    {
+        std::cerr << "Error: Unable to write trace file: "
+                  << CliArguments::getOptionValue(options, "--trace", "steamdb_trace.json") << std::endl;
+    }
+}
+
 // Main function to run the Steamdb CLI program
 int main(int argc, char *argv[])
 {
-    Logger logger;
-    logger.init("steamdb_cli.log");
-
     GameCache gameCache;
+    Scraper scraper;
     std::vector<std::string> searchHistory;
 
+    std::string gameNameArgument;
+    std::vector<std::string> options;
+    CliArguments::parseArguments(argc, argv, gameNameArgument, options);
+    bool interactive = gameNameArgument.empty() && !CliArguments::hasOption(options, "--batch") &&
+                       !CliArguments::hasOption(options, "--sales");
+
     Config &config = Config::getInstance();
 
     // Try to load config from multiple locations
@@ -225,17 +490,17 @@ int main(int argc, char *argv[])
             testFile.close();
             config.load(path);
             configLoaded = true;
-            std::cout << "Configuration loaded from: " << path << std::endl;
+            std::cerr << "Configuration loaded from: " << path << std::endl;
 
             // Debug: Check if Steam API key was actually loaded
             std::string apiKey = config.get("STEAM_API_KEY");
             if (!apiKey.empty())
             {
-                std::cout << "Steam API key found in configuration." << std::endl;
+                std::cerr << "Steam API key found in configuration." << std::endl;
             }
             else
             {
-                std::cout << "Warning: Steam API key not found in " << path << std::endl;
+                std::cerr << "Warning: Steam API key not found in " << path << std::endl;
             }
             break;
         }
@@ -243,20 +508,68 @@ int main(int argc, char *argv[])
 
     if (!configLoaded)
     {
-        std::cout << "Warning: config.txt not found. Please ensure config.txt is in the same directory as the executable." << std::endl;
+        std::cerr << "Warning: config.txt not found. Please ensure config.txt is in the same directory as the executable." << std::endl;
     }
 
-    applyUserConfigurations(config);
+    // Log file, level and rotation limits come from the config; 0 disables a limit
+    Logger &logger = Logger::getInstance();
+    std::string logFile = config.get("LOG_FILE");
+    LogRotation rotation;
+    rotation.maxBytes = static_cast<uint64_t>(std::max(0LL, config.getInt("LOG_MAX_SIZE_MB", 10))) * 1024 * 1024;
+    rotation.maxAge = std::chrono::hours(std::max(0LL, config.getInt("LOG_MAX_AGE_HOURS", 24)));
+    rotation.maxTotalBytes = static_cast<uint64_t>(std::max(0LL, config.getInt("LOG_MAX_TOTAL_MB", 100))) * 1024 * 1024;
+    logger.init(logFile.empty() ? "steamdb_cli.log" : logFile, Logger::parseLevel(config.get("LOG_LEVEL")), rotation);
+
+    // Record spans from here on; they are written out at exit
+    if (CliArguments::hasOption(options, "--trace"))
+    {
+        Tracer::getInstance().start(CliArguments::getOptionValue(options, "--trace", "steamdb_trace.json"));
+        Tracer::getInstance().nameThread("main");
+    }
+
+    // Open the on-disk cache shared across runs
+    std::string cacheFile = config.get("CACHE_FILE");
+    PersistentCache &persistentCache = PersistentCache::getInstance();
+    persistentCache.open(cacheFile.empty() ? "steamdb_cache.bin" : cacheFile);
+
+    // Bound the in-memory cache by bytes rather than entries
+    std::string cacheLimitMb = config.get("CACHE_MEMORY_LIMIT_MB");
+    if (!cacheLimitMb.empty())
+    {
+        try
+        {
+            gameCache.setMaxBytes(static_cast<size_t>(std::stoul(cacheLimitMb)) * 1024 * 1024);
+        }
+        catch (const std::exception &)
+        {
+            LOG_WARNING("Invalid CACHE_MEMORY_LIMIT_MB value: {}", cacheLimitMb);
+        }
+    }
 
     // Initialize Steam API helper
     SteamApiHelper steamApi;
     bool steamApiAvailable = steamApi.initialize();
     if (!steamApiAvailable)
     {
-        std::cout << "Warning: Steam API not available. Some features may be limited." << std::endl;
+        std::cerr << "Warning: Steam API not available. Some features may be limited." << std::endl;
         logger.warning("Steam API initialization failed");
     }
 
+    // Stdout carries only results when running non-interactively
+    if (!interactive)
+    {
+        BatchRunner runner(steamApi, steamApiAvailable, gameCache, scraper);
+        int exitCode = runNonInteractive(steamApi, steamApiAvailable, runner, gameNameArgument, options, logger);
+        persistentCache.flush();
+        if (CliArguments::hasOption(options, "--stats"))
+        {
+            Metrics::getInstance().report(std::cerr);
+        }
+        writeTrace(options);
+        return exitCode;
+    }
+
+    applyUserConfigurations(config);
     printHeader();
     displayCurrentTime();
     displayRandomQuote();
@@ -267,7 +580,7 @@ int main(int argc, char *argv[])
     std::cout << "2. View current Steam sales" << std::endl;
     std::cout << "3. View featured sales" << std::endl;
     std::cout << "4. View special offers" << std::endl;
-    std::cout << "Type 'exit' to quit" << std::endl;
+    std::cout << "Type 'stats' for request statistics or 'exit' to quit" << std::endl;
 
     while (true)
     {
@@ -279,6 +592,11 @@ int main(int argc, char *argv[])
         {
             break;
         }
+        if (input == "stats")
+        {
+            Metrics::getInstance().report(std::cout);
+            continue;
+        }
 
         // Handle menu options
         if (input == "1")
@@ -401,11 +719,17 @@ int main(int argc, char *argv[])
 
         try
         {
-            if (gameCache.hasGame(gameName))
+            GameData diskData;
+            if (std::shared_ptr<const GameData> cachedData = gameCache.getGame(gameName))
+            {
+                displayGameInfo(*cachedData);
+                LOG_INFO("Fetched cached data for game: {}", gameName);
+            }
+            else if (persistentCache.loadGame(gameName, diskData))
             {
-                GameData cachedData = gameCache.getGame(gameName);
-                displayGameInfo(cachedData);
-                logger.info("Fetched cached data for game: " + gameName);
+                gameCache.addGame(gameName, diskData);
+                displayGameInfo(diskData);
+                LOG_INFO("Fetched data for game from disk cache: {}", gameName);
             }
             else
             {
@@ -437,7 +761,7 @@ int main(int argc, char *argv[])
                             {
                                 displaySteamGameInfo(steamGame);
                                 foundWithSteamApi = true;
-                                logger.info("Fetched Steam API data for App ID: " + gameName);
+                                LOG_INFO("Fetched Steam API data for App ID: {}", gameName);
                             }
                         }
                         else
@@ -457,7 +781,7 @@ int main(int argc, char *argv[])
                                 }
 
                                 foundWithSteamApi = true;
-                                logger.info("Found Steam API results for: " + gameName);
+                                LOG_INFO("Found Steam API results for: {}", gameName);
                             }
                             else
                             {
@@ -469,25 +793,21 @@ int main(int argc, char *argv[])
                     catch (const std::exception &e)
                     {
                         std::cout << "Steam API search failed, falling back to web scraping..." << std::endl;
-                        logger.warning("Steam API search failed for: " + gameName + " - " + e.what());
+                        LOG_WARNING("Steam API search failed for: {} - {}", gameName, e.what());
                     }
                 }
 
                 // Fall back to web scraping if Steam API didn't work
                 if (!foundWithSteamApi)
                 {
-                    Scraper scraper;
                     std::cout << "Fetching data for game: " << gameName << std::endl;
-                    for (int i = 0; i <= 100; ++i)
-                    {
-                        displayProgressBar(i, 100);
-                        std::this_thread::sleep_for(std::chrono::milliseconds(20));
-                    }
-                    std::cout << std::endl;
+                    ConsoleProgress progress;
+                    NetworkUtils::ProgressScope progressScope(&progress);
                     GameData gameData = scraper.searchGame(gameName);
                     gameCache.addGame(gameName, gameData);
+                    persistentCache.storeGame(gameName, gameData);
                     displayGameInfo(gameData);
-                    logger.info("Fetched data for game: " + gameName);
+                    LOG_INFO("Fetched data for game: {}", gameName);
                 }
             }
         }
@@ -495,13 +815,13 @@ int main(int argc, char *argv[])
         {
             std::cerr << "\033[1;31mNetwork Error: " << e.what() << "\033[0m" << std::endl;
             std::cerr << "Please check your internet connection and try again." << std::endl;
-            logger.error("Network error while fetching data for game: " + gameName, __FUNCTION__, __FILE__, __LINE__);
+            LOG_ERROR("Network error while fetching data for game: {} [Function: {}, File: {}, Line: {}]", gameName, __FUNCTION__, __FILE__, __LINE__);
         }
         catch (const std::exception &e)
         {
             std::cerr << "\033[1;31mError: " << e.what() << "\033[0m" << std::endl;
             std::cerr << "An unexpected error occurred. Please try again later." << std::endl;
-            logger.error("Error while fetching data for game: " + gameName, __FUNCTION__, __FILE__, __LINE__);
+            LOG_ERROR("Error while fetching data for game: {} [Function: {}, File: {}, Line: {}]", gameName, __FUNCTION__, __FILE__, __LINE__);
         }
     }
 
@@ -512,6 +832,16 @@ int main(int argc, char *argv[])
         std::cout << search << std::endl;
     }
 
+    GameCache::Stats cacheStats = gameCache.getStats();
+    LOG_INFO("Game cache: {} hits, {} misses, {} evictions, {} of {} bytes used", cacheStats.hits, cacheStats.misses,
+             cacheStats.evictions, cacheStats.bytes, cacheStats.maxBytes);
+
+    persistentCache.flush();
+    if (CliArguments::hasOption(options, "--stats"))
+    {
+        Metrics::getInstance().report(std::cout);
+    }
+    writeTrace(options);
     resetTextColor();
 
     return 0;
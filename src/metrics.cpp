@@ -0,0 +1,253 @@
+#include "metrics.h"
+#include "connection_pool.h"
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+static uint64_t toMicros(double milliseconds)
+{
+    return milliseconds > 0 ? static_cast<uint64_t>(milliseconds * 1000.0) : 0;
+}
+
+Metrics::Histogram::Histogram()
+{
+    for (auto &bucket : buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+int Metrics::Histogram::bucketFor(uint64_t micros)
+{
+    micros = std::min<uint64_t>(micros, (uint64_t(1) << (MAX_MAGNITUDE + 1)) - 1);
+    if (micros < 2 * SUB_BUCKETS)
+    {
+        return static_cast<int>(micros);
+    }
+    int magnitude = 63;
+    while (!(micros >> magnitude))
+    {
+        --magnitude;
+    }
+    int shift = magnitude - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + static_cast<int>(micros >> shift) - SUB_BUCKETS;
+}
+
+uint64_t Metrics::Histogram::bucketMidpoint(int bucket)
+{
+    if (bucket < 2 * SUB_BUCKETS)
+    {
+        return static_cast<uint64_t>(bucket);
+    }
+    int shift = bucket / SUB_BUCKETS - 1;
+    uint64_t low = uint64_t(bucket % SUB_BUCKETS + SUB_BUCKETS) << shift;
+    return low + (uint64_t(1) << shift) / 2;
+}
+
+void Metrics::Histogram::record(uint64_t micros)
+{
+    buckets[bucketFor(micros)].fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t Metrics::Histogram::count() const
+{
+    uint64_t total = 0;
+    for (const auto &bucket : buckets)
+    {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t Metrics::Histogram::percentile(double percent) const
+{
+    uint64_t total = count();
+    if (total == 0)
+    {
+        return 0;
+    }
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(percent / 100.0 * total + 0.5));
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; ++i)
+    {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            return bucketMidpoint(i);
+        }
+    }
+    return bucketMidpoint(BUCKETS - 1);
+}
+
+Metrics &Metrics::getInstance()
+{
+    static Metrics instance;
+    return instance;
+}
+
+std::string Metrics::endpointName(const std::string &url)
+{
+    std::string host = ConnectionPool::hostFromUrl(url);
+    size_t start = url.find("://");
+    start = url.find('/', start == std::string::npos ? 0 : start + 3);
+    std::string path = start == std::string::npos ? "" : url.substr(start, url.find_first_of("?#", start) - start);
+
+    // Drop IDs and version segments so /app/570/ and /app/730/ share an endpoint
+    std::vector<std::string> segments;
+    std::istringstream parts(path);
+    std::string segment;
+    while (std::getline(parts, segment, '/'))
+    {
+        bool numeric = !segment.empty() && std::all_of(segment.begin(), segment.end(), ::isdigit);
+        bool version = segment.size() > 1 && segment[0] == 'v' &&
+                       std::all_of(segment.begin() + 1, segment.end(), ::isdigit);
+        if (!segment.empty() && !numeric && !version)
+        {
+            segments.push_back(segment);
+        }
+    }
+
+    // Steam Web API: /ISteamUser/GetPlayerSummaries/v0002/ is known by its method
+    for (size_t i = 0; i + 1 < segments.size(); ++i)
+    {
+        if (segments[i].size() > 1 && segments[i][0] == 'I' && std::isupper(static_cast<unsigned char>(segments[i][1])))
+        {
+            return segments[i + 1];
+        }
+    }
+
+    std::string name = host;
+    for (const std::string &part : segments)
+    {
+        name += "/" + part;
+    }
+    return name;
+}
+
+Metrics::Endpoint &Metrics::endpoint(const std::string &url)
+{
+    std::string name = endpointName(url);
+    {
+        std::shared_lock<std::shared_mutex> lock(registryMutex);
+        auto it = endpoints.find(name);
+        if (it != endpoints.end())
+        {
+            return *it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(registryMutex);
+    auto &entry = endpoints[name];
+    if (!entry)
+    {
+        entry = std::make_unique<Endpoint>();
+    }
+    return *entry;
+}
+
+void Metrics::recordTransfer(const std::string &url, const NetworkUtils::HttpResponse &response)
+{
+    Endpoint &stats = endpoint(url);
+    const NetworkUtils::TransferTiming &timing = response.timing;
+    stats.requests.fetch_add(1, std::memory_order_relaxed);
+    if (response.status >= 400)
+    {
+        stats.failures.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (response.notModified)
+    {
+        stats.notModified.fetch_add(1, std::memory_order_relaxed);
+    }
+    stats.wireBytes.fetch_add(static_cast<uint64_t>(timing.bytes), std::memory_order_relaxed);
+    stats.decodedBytes.fetch_add(static_cast<uint64_t>(timing.decodedBytes), std::memory_order_relaxed);
+
+    // curl timings are cumulative from the start; DNS, connect and TLS only happen on a new connection
+    if (timing.connectMs > 0)
+    {
+        stats.dns.record(toMicros(timing.dnsMs));
+        stats.connect.record(toMicros(timing.connectMs - timing.dnsMs));
+    }
+    if (timing.tlsMs > 0)
+    {
+        stats.tls.record(toMicros(timing.tlsMs - timing.connectMs));
+    }
+    stats.firstByte.record(toMicros(timing.firstByteMs));
+    stats.total.record(toMicros(timing.totalMs));
+}
+
+void Metrics::recordFailure(const std::string &url)
+{
+    Endpoint &stats = endpoint(url);
+    stats.requests.fetch_add(1, std::memory_order_relaxed);
+    stats.failures.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordRetry(const std::string &url)
+{
+    endpoint(url).retries.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordCacheHit(const std::string &url)
+{
+    endpoint(url).cacheHits.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordRateLimitWait(const std::string &url, std::chrono::nanoseconds wait)
+{
+    Endpoint &stats = endpoint(url);
+    uint64_t micros = static_cast<uint64_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(wait).count()));
+    stats.rateLimitWait.record(micros);
+    stats.rateLimitWaitMicros.fetch_add(micros, std::memory_order_relaxed);
+}
+
+bool Metrics::empty() const
+{
+    std::shared_lock<std::shared_mutex> lock(registryMutex);
+    return endpoints.empty();
+}
+
+void Metrics::report(std::ostream &out) const
+{
+    std::shared_lock<std::shared_mutex> lock(registryMutex);
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1);
+    if (endpoints.empty())
+    {
+        text << "No requests recorded." << std::endl;
+    }
+    for (const auto &entry : endpoints)
+    {
+        const Endpoint &stats = *entry.second;
+        text << entry.first << ": " << stats.requests.load() << " request(s), " << stats.failures.load() << " failed, "
+             << stats.retries.load() << " retried, " << stats.cacheHits.load() << " cache hit(s), "
+             << stats.notModified.load() << " not modified, " << stats.wireBytes.load() / 1024.0 << " KB ("
+             << stats.decodedBytes.load() / 1024.0 << " KB decoded), rate-limit wait "
+             << stats.rateLimitWaitMicros.load() / 1000.0 << " ms" << std::endl;
+
+        const std::pair<const char *, const Histogram *> phases[] = {
+            {"rate-limit wait", &stats.rateLimitWait},
+            {"dns", &stats.dns},
+            {"connect", &stats.connect},
+            {"tls", &stats.tls},
+            {"first byte", &stats.firstByte},
+            {"total", &stats.total},
+        };
+        text << "  " << std::left << std::setw(16) << "phase" << std::right << std::setw(8) << "count"
+             << std::setw(11) << "p50 ms" << std::setw(11) << "p95 ms" << std::setw(11) << "p99 ms" << std::endl;
+        for (const auto &phase : phases)
+        {
+            uint64_t count = phase.second->count();
+            if (count == 0)
+            {
+                continue;
+            }
+            text << "  " << std::left << std::setw(16) << phase.first << std::right << std::setw(8) << count
+                 << std::setprecision(2) << std::setw(11) << phase.second->percentile(50) / 1000.0 << std::setw(11)
+                 << phase.second->percentile(95) / 1000.0 << std::setw(11) << phase.second->percentile(99) / 1000.0
+                 << std::setprecision(1) << std::endl;
+        }
+    }
+    out << text.str() << std::flush;
+}
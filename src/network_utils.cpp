@@ -1,12 +1,27 @@
 #include "network_utils.h"
 #include "config.h"
+#include "connection_pool.h"
+#include "async_fetcher.h"
+#include "rate_limiter.h"
+#include "logger.h"
+#include "metrics.h"
+#include "tracer.h"
 #include <curl/curl.h>
 #include <sstream>
 #include <iomanip>
 #include "error_handling.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <mutex>
+#include <random>
+#include <unordered_map>
 #include <thread>
 #include <chrono>
 
+// Longest delay a retry will wait; a server asking for more is treated as a hard failure
+static const std::chrono::milliseconds MAX_RETRY_DELAY(60000);
+
 // Callback function to write data received from the server to a string
 static size_t WriteCallback(void *contents, size_t size, size_t nmemb, void *userp)
 {
@@ -14,60 +29,504 @@ static size_t WriteCallback(void *contents, size_t size, size_t nmemb, void *use
     return size * nmemb;
 }
 
+// Write target of a streaming transfer
+struct StreamContext
+{
+    std::string *body;
+    const NetworkUtils::StreamCallback *onData;
+    bool stopped;
+};
+
+// Append a chunk and let the receiver look at the body so far; returning a short count
+// makes curl abort the transfer with CURLE_WRITE_ERROR
+static size_t StreamWriteCallback(void *contents, size_t size, size_t nmemb, void *userp)
+{
+    auto *context = static_cast<StreamContext *>(userp);
+    context->body->append(static_cast<char *>(contents), size * nmemb);
+    if (!(*context->onData)(*context->body))
+    {
+        context->stopped = true;
+        return 0;
+    }
+    return size * nmemb;
+}
+
+// Fetches in flight keyed by normalized URL; later callers for the same URL wait on the
+// first one instead of spending another request and rate-limit permit
+static std::mutex flightMutex;
+static std::unordered_map<std::string, std::shared_future<AsyncFetcher::Body>> flights;
+
+// Streaming fetches in flight, also guarded by flightMutex; the body is partial when the
+// first caller stopped the transfer early
+struct StreamedBody
+{
+    AsyncFetcher::Body body;
+    bool stopped;
+};
+static std::unordered_map<std::string, std::shared_future<StreamedBody>> streams;
+
+static void endFlight(const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(flightMutex);
+    flights.erase(key);
+}
+
+static void endStream(const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(flightMutex);
+    streams.erase(key);
+}
+
+// Body bytes of all completed transfers
+static std::atomic<uint64_t> totalTransfers(0);
+static std::atomic<uint64_t> totalWireBytes(0);
+static std::atomic<uint64_t> totalDecodedBytes(0);
+
+// Progress listener of the current thread, if any
+static thread_local NetworkUtils::ProgressListener *currentListener = nullptr;
+
+// Per-transfer state handed to the progress callback
+struct ProgressContext
+{
+    NetworkUtils::ProgressListener *listener;
+    const std::string *host;
+};
+
+// Forward curl transfer progress to the listener
+static int ProgressCallback(void *clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t, curl_off_t)
+{
+    auto *context = static_cast<ProgressContext *>(clientp);
+    context->listener->onProgress(*context->host, dlnow, dltotal);
+    return 0;
+}
+
+// Convert a curl microsecond timing value to milliseconds
+static double timingMs(CURL *curl, CURLINFO info)
+{
+    curl_off_t micros = 0;
+    curl_easy_getinfo(curl, info, &micros);
+    return micros / 1000.0;
+}
+
+// Callback collecting response headers; a new status line starts a fresh header set
+// so only the final response of a redirect chain is kept
+static size_t HeaderCallback(char *buffer, size_t size, size_t nitems, void *userp)
+{
+    auto *headers = static_cast<std::vector<std::pair<std::string, std::string>> *>(userp);
+    std::string_view line(buffer, size * nitems);
+    if (line.compare(0, 5, "HTTP/") == 0)
+    {
+        headers->clear();
+        return size * nitems;
+    }
+
+    size_t colon = line.find(':');
+    if (colon == std::string_view::npos)
+    {
+        return size * nitems;
+    }
+    std::string name(line.substr(0, colon));
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c)
+                   { return static_cast<char>(std::tolower(c)); });
+    std::string_view value = line.substr(colon + 1);
+    size_t first = value.find_first_not_of(" \t\r\n");
+    size_t last = value.find_last_not_of(" \t\r\n");
+    value = (first == std::string_view::npos) ? std::string_view() : value.substr(first, last - first + 1);
+    headers->emplace_back(std::move(name), std::string(value));
+    return size * nitems;
+}
+
 namespace NetworkUtils
 {
 
+    ProgressScope::ProgressScope(ProgressListener *listener) : previous(currentListener)
+    {
+        currentListener = listener;
+    }
+
+    ProgressScope::~ProgressScope()
+    {
+        currentListener = previous;
+    }
+
+    std::string HttpResponse::header(std::string_view name) const
+    {
+        for (const auto &entry : headers)
+        {
+            if (entry.first == name)
+            {
+                return entry.second;
+            }
+        }
+        return "";
+    }
+
+    void prepareTransfer(CURL *curl, const std::string &url, HttpResponse &response)
+    {
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response.body);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeaderCallback);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &response.headers);
+
+        response.cached = ResponseCache::getInstance().find(normalizeUrl(url));
+        if (response.cached && response.cached->hasValidators())
+        {
+            curl_slist *headers = nullptr;
+            if (!response.cached->etag.empty())
+            {
+                headers = curl_slist_append(headers, ("If-None-Match: " + response.cached->etag).c_str());
+            }
+            if (!response.cached->lastModified.empty())
+            {
+                headers = curl_slist_append(headers, ("If-Modified-Since: " + response.cached->lastModified).c_str());
+            }
+            response.requestHeaders.reset(headers, curl_slist_free_all);
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        }
+    }
+
+    void completeTransfer(CURL *curl, const std::string &url, HttpResponse &response)
+    {
+        curl_off_t retryAfter = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response.status);
+        response.timing.dnsMs = timingMs(curl, CURLINFO_NAMELOOKUP_TIME_T);
+        response.timing.connectMs = timingMs(curl, CURLINFO_CONNECT_TIME_T);
+        response.timing.tlsMs = timingMs(curl, CURLINFO_APPCONNECT_TIME_T);
+        response.timing.firstByteMs = timingMs(curl, CURLINFO_STARTTRANSFER_TIME_T);
+        response.timing.totalMs = timingMs(curl, CURLINFO_TOTAL_TIME_T);
+        curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &response.timing.bytes);
+        response.timing.decodedBytes = static_cast<curl_off_t>(response.body.size());
+        totalTransfers.fetch_add(1, std::memory_order_relaxed);
+        totalWireBytes.fetch_add(static_cast<uint64_t>(response.timing.bytes), std::memory_order_relaxed);
+        totalDecodedBytes.fetch_add(static_cast<uint64_t>(response.timing.decodedBytes), std::memory_order_relaxed);
+        if (curl_easy_getinfo(curl, CURLINFO_RETRY_AFTER, &retryAfter) == CURLE_OK && retryAfter > 0)
+        {
+            response.retryAfter = std::chrono::seconds(retryAfter);
+        }
+        RateLimiter::getInstance().recordResponse(url, response.status, response.retryAfter);
+
+        ResponseCache &cache = ResponseCache::getInstance();
+        if (response.status == 304 && response.cached)
+        {
+            auto entry = cache.refresh(normalizeUrl(url), response.cached, response.header("cache-control"),
+                                       response.header("etag"), response.header("last-modified"));
+            response.status = 200;
+            response.body = *entry->body;
+            response.notModified = true;
+        }
+        else if (response.status == 200 && !response.stopped)
+        {
+            cache.store(normalizeUrl(url), response.body, response.header("cache-control"), response.header("etag"),
+                        response.header("last-modified"));
+        }
+        response.cached.reset();
+        Metrics::getInstance().recordTransfer(url, response);
+    }
+
+    TransferTotals transferTotals()
+    {
+        TransferTotals totals;
+        totals.transfers = totalTransfers.load(std::memory_order_relaxed);
+        totals.wireBytes = totalWireBytes.load(std::memory_order_relaxed);
+        totals.decodedBytes = totalDecodedBytes.load(std::memory_order_relaxed);
+        return totals;
+    }
+
+    // Perform a blocking transfer; with onData set the body is handed over as it arrives
+    static HttpResponse performTransfer(const std::string &url, const StreamCallback *onData)
+    {
+        {
+            TRACE_SCOPE("rate-limit wait", "ratelimit", url);
+            auto waitStart = std::chrono::steady_clock::now();
+            RateLimiter::getInstance().acquire(url);
+            Metrics::getInstance().recordRateLimitWait(url, std::chrono::steady_clock::now() - waitStart);
+        }
+        TRACE_SCOPE("GET", "network", url);
+        ConnectionPool::Handle handle = ConnectionPool::getInstance().acquire(url);
+        CURL *curl = handle.get();
+        HttpResponse response;
+
+        prepareTransfer(curl, url, response);
+        StreamContext stream{&response.body, onData, false};
+        if (onData)
+        {
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, StreamWriteCallback);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &stream);
+        }
+        std::string host;
+        ProgressContext progress{currentListener, &host};
+        if (currentListener)
+        {
+            host = ConnectionPool::hostFromUrl(url);
+            curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, ProgressCallback);
+            curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &progress);
+            curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        }
+        CURLcode res = curl_easy_perform(curl);
+        response.stopped = (res == CURLE_WRITE_ERROR && stream.stopped);
+        if (res != CURLE_OK && !response.stopped)
+        {
+            Metrics::getInstance().recordFailure(url);
+            throw NetworkError("Failed to fetch page: " + std::string(curl_easy_strerror(res)));
+        }
+        completeTransfer(curl, url, response);
+        LOG_DEBUG("GET {} -> {} in {} ms ({} bytes{})", url, response.status, response.timing.totalMs,
+                  response.timing.bytes, response.stopped ? ", stopped early" : "");
+        if (currentListener)
+        {
+            currentListener->onComplete(host, response.timing);
+        }
+        return response;
+    }
+
+    // Fetch a URL and return the raw HTTP response
+    HttpResponse fetchResponse(const std::string &url)
+    {
+        return performTransfer(url, nullptr);
+    }
+
+    // Stream one transfer to the receiver; throws HttpError for 4xx/5xx
+    static HttpResponse streamTransfer(const std::string &url, const StreamCallback &onData)
+    {
+        HttpResponse response = performTransfer(url, &onData);
+        if (response.status >= 400)
+        {
+            throw HttpError(response.status, response.retryAfter,
+                            "HTTP " + std::to_string(response.status) + " from " + ConnectionPool::hostFromUrl(url));
+        }
+        if (response.notModified)
+        {
+            // Revalidated: the body came from the cache rather than the write callback
+            response.stopped = !onData(response.body);
+        }
+        return response;
+    }
+
+    HttpResponse fetchStreaming(const std::string &url, const StreamCallback &onData)
+    {
+        TRACE_SCOPE("fetchStreaming", "network", url);
+        std::string key = normalizeUrl(url);
+        auto cached = ResponseCache::getInstance().find(key);
+        if (cached && cached->isFresh())
+        {
+            Metrics::getInstance().recordCacheHit(url);
+            HttpResponse response;
+            response.status = 200;
+            response.body = *cached->body;
+            response.stopped = !onData(response.body);
+            return response;
+        }
+
+        // Join a fetch of the same page that is already in flight, streaming or not
+        std::shared_future<AsyncFetcher::Body> page;
+        std::shared_future<StreamedBody> stream;
+        std::promise<StreamedBody> promise;
+        {
+            std::lock_guard<std::mutex> lock(flightMutex);
+            auto flight = flights.find(key);
+            auto streamed = streams.find(key);
+            if (flight != flights.end())
+            {
+                page = flight->second;
+            }
+            else if (streamed != streams.end())
+            {
+                stream = streamed->second;
+            }
+            else
+            {
+                streams.emplace(key, promise.get_future().share());
+            }
+        }
+        if (page.valid() || stream.valid())
+        {
+            HttpResponse response;
+            response.status = 200;
+            bool partial = false;
+            {
+                TRACE_SCOPE("coalesced wait", "network", url);
+                if (page.valid())
+                {
+                    response.body = *page.get();
+                }
+                else
+                {
+                    const StreamedBody &streamed = stream.get();
+                    response.body = *streamed.body;
+                    partial = streamed.stopped;
+                }
+            }
+            response.stopped = !onData(response.body);
+            if (response.stopped || !partial)
+            {
+                return response;
+            }
+
+            // The first caller stopped before the part this one needs: fetch the page again,
+            // handing it over only past what was already seen
+            size_t seen = response.body.size();
+            StreamCallback onMore = [&onData, seen](const std::string &received)
+            { return received.size() <= seen || onData(received); };
+            return streamTransfer(url, onMore);
+        }
+
+        try
+        {
+            HttpResponse response = streamTransfer(url, onData);
+            promise.set_value(StreamedBody{std::make_shared<const std::string>(response.body), response.stopped});
+            endStream(key);
+            return response;
+        }
+        catch (...)
+        {
+            promise.set_exception(std::current_exception());
+            endStream(key);
+            throw;
+        }
+    }
+
     // Fetch the HTML content of a web page
     std::string fetchPage(const std::string &url)
     {
-        CURL *curl;
-        CURLcode res;
-        std::string readBuffer;
-        curl = curl_easy_init();
-        if (curl)
+        TRACE_SCOPE("fetchPage", "network", url);
+        std::string key = normalizeUrl(url);
+        auto cached = ResponseCache::getInstance().find(key);
+        if (cached && cached->isFresh())
+        {
+            Metrics::getInstance().recordCacheHit(url);
+            return *cached->body;
+        }
+
+        std::promise<AsyncFetcher::Body> promise;
+        {
+            std::unique_lock<std::mutex> lock(flightMutex);
+            auto flight = flights.find(key);
+            if (flight != flights.end())
+            {
+                std::shared_future<AsyncFetcher::Body> result = flight->second;
+                lock.unlock();
+                TRACE_SCOPE("coalesced wait", "network", url);
+                return *result.get();
+            }
+            flights.emplace(key, promise.get_future().share());
+        }
+
+        try
         {
-            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-            res = curl_easy_perform(curl);
-            curl_easy_cleanup(curl);
-            if (res != CURLE_OK)
+            HttpResponse response = fetchResponse(url);
+            if (response.status >= 400)
             {
-                throw NetworkError("Failed to fetch page: " + std::string(curl_easy_strerror(res)));
+                throw HttpError(response.status, response.retryAfter,
+                                "HTTP " + std::to_string(response.status) + " from " + ConnectionPool::hostFromUrl(url));
             }
+            auto body = std::make_shared<const std::string>(std::move(response.body));
+            promise.set_value(body);
+            endFlight(key);
+            return *body;
         }
-        else
+        catch (...)
         {
-            throw NetworkError("Failed to initialize CURL for fetching page");
+            promise.set_exception(std::current_exception());
+            endFlight(key);
+            throw;
         }
-        return readBuffer;
     }
 
-    // Check if there is an active internet connection
-    bool checkInternetConnection()
+    std::string normalizeUrl(const std::string &url)
     {
-        CURL *curl;
-        CURLcode res;
-        curl = curl_easy_init();
-        if (curl)
+        std::string normalized = url.substr(0, url.find('#'));
+
+        // Lowercase scheme and authority
+        size_t schemeEnd = normalized.find("://");
+        size_t authorityEnd = normalized.find_first_of("/?", schemeEnd == std::string::npos ? 0 : schemeEnd + 3);
+        std::transform(normalized.begin(), authorityEnd == std::string::npos ? normalized.end() : normalized.begin() + authorityEnd,
+                       normalized.begin(), [](unsigned char c)
+                       { return static_cast<char>(std::tolower(c)); });
+
+        // Sort query parameters so their order does not matter
+        size_t queryStart = normalized.find('?');
+        if (queryStart == std::string::npos)
         {
-            curl_easy_setopt(curl, CURLOPT_URL, "http://www.google.com");
-            curl_easy_setopt(curl, CURLOPT_NOBODY, 1);
-            res = curl_easy_perform(curl);
-            curl_easy_cleanup(curl);
-            if (res == CURLE_OK)
+            return normalized;
+        }
+        std::vector<std::string> parameters;
+        std::istringstream query(normalized.substr(queryStart + 1));
+        std::string parameter;
+        while (std::getline(query, parameter, '&'))
+        {
+            if (!parameter.empty())
             {
-                return true;
+                parameters.push_back(parameter);
             }
-            else
+        }
+        std::sort(parameters.begin(), parameters.end());
+        normalized.resize(queryStart);
+        for (size_t i = 0; i < parameters.size(); ++i)
+        {
+            normalized += (i == 0 ? '?' : '&');
+            normalized += parameters[i];
+        }
+        return normalized;
+    }
+
+    bool planRetry(const std::exception_ptr &error, int attempt, int maxRetries, int retryDelay,
+                   std::chrono::milliseconds &delay)
+    {
+        if (attempt + 1 >= maxRetries)
+        {
+            return false;
+        }
+
+        std::chrono::milliseconds retryAfter(0);
+        try
+        {
+            std::rethrow_exception(error);
+        }
+        catch (const HttpError &e)
+        {
+            long status = e.status();
+            if (status != 408 && status != 429 && status < 500)
             {
-                throw NetworkError("Failed to check internet connection: " + std::string(curl_easy_strerror(res)));
+                return false;
             }
+            retryAfter = e.retryAfter();
+        }
+        catch (const NetworkError &)
+        {
         }
-        else
+        catch (...)
         {
-            throw NetworkError("Failed to initialize CURL for internet connection check");
+            return false;
+        }
+
+        // Equal jitter: half the exponential step is fixed, the other half random
+        static thread_local std::mt19937 random(std::random_device{}());
+        int64_t step = std::min<int64_t>(int64_t(retryDelay) << std::min(attempt, 16), MAX_RETRY_DELAY.count());
+        std::uniform_int_distribution<int64_t> jitter(0, step / 2);
+        delay = std::max(std::chrono::milliseconds(step - step / 2 + jitter(random)), retryAfter);
+        if (delay > MAX_RETRY_DELAY)
+        {
+            return false;
         }
+        return RateLimiter::getInstance().tryRetry();
+    }
+
+    // Check if there is an active internet connection
+    bool checkInternetConnection()
+    {
+        const std::string url = "http://www.google.com";
+        ConnectionPool::Handle handle = ConnectionPool::getInstance().acquire(url);
+        CURL *curl = handle.get();
+
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+        CURLcode res = curl_easy_perform(curl);
+        if (res != CURLE_OK)
+        {
+            throw NetworkError("Failed to check internet connection: " + std::string(curl_easy_strerror(res)));
+        }
+        return true;
     }
 
     // Encode a URL string to make it safe for use in a URL
@@ -104,27 +563,61 @@ namespace NetworkUtils
     // Fetch the HTML content of a web page with retry mechanism
     std::string fetchPageWithRetry(const std::string &url, int maxRetries, int retryDelay)
     {
-        int attempt = 0;
-        while (attempt < maxRetries)
+        TRACE_SCOPE("fetchPageWithRetry", "network", url);
+        RateLimiter::getInstance().recordRequest();
+        for (int attempt = 0;; ++attempt)
         {
             try
             {
                 return fetchPage(url);
             }
-            catch (const NetworkError &e)
+            catch (const NetworkError &)
             {
-                if (attempt < maxRetries - 1)
-                {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(retryDelay));
-                }
-                else
+                std::chrono::milliseconds delay;
+                if (!planRetry(std::current_exception(), attempt, maxRetries, retryDelay, delay))
                 {
                     throw;
                 }
+                Logger::getInstance().logRetryAttempt(url, attempt + 1);
+                Metrics::getInstance().recordRetry(url);
+                TRACE_SCOPE("retry delay", "network", url);
+                std::this_thread::sleep_for(delay);
             }
-            ++attempt;
         }
-        throw NetworkError("Failed to fetch page after " + std::to_string(maxRetries) + " attempts");
+    }
+
+    // Queue a fetch on the shared curl_multi engine
+    std::future<std::string> fetchPageAsync(const std::string &url, int maxRetries, int retryDelay)
+    {
+        std::string key = normalizeUrl(url);
+        std::shared_future<AsyncFetcher::Body> result;
+        auto cached = ResponseCache::getInstance().find(key);
+        if (cached && cached->isFresh())
+        {
+            Metrics::getInstance().recordCacheHit(url);
+            AsyncFetcher::Body body = cached->body;
+            return std::async(std::launch::deferred, [body]()
+                              { return *body; });
+        }
+        {
+            // Registered under the lock so onDone cannot run before the flight exists
+            std::lock_guard<std::mutex> lock(flightMutex);
+            auto flight = flights.find(key);
+            if (flight != flights.end())
+            {
+                result = flight->second;
+            }
+            else
+            {
+                result = AsyncFetcher::getInstance().fetch(url, maxRetries, retryDelay, [key]()
+                                                           { endFlight(key); });
+                flights.emplace(key, result);
+            }
+        }
+
+        // Each caller gets its own future; the body is copied out only when it is read
+        return std::async(std::launch::deferred, [result]()
+                          { return *result.get(); });
     }
 
     // Steam API specific functions
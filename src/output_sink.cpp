@@ -0,0 +1,353 @@
+#include "output_sink.h"
+#include <charconv>
+
+// Buffer capacity, and the fill level that triggers a write
+static const size_t BUFFER_CAPACITY = 1 << 20;
+static const size_t FLUSH_THRESHOLD = BUFFER_CAPACITY - 64 * 1024;
+
+// Longest time a finished record may sit in the buffer, so slow streams still show progress
+static const std::chrono::milliseconds MAX_PENDING(250);
+
+// Join a list of values with ';' for single-cell output
+static std::string joinList(const std::vector<std::string> &values)
+{
+    std::string joined;
+    for (const auto &value : values)
+    {
+        if (!joined.empty())
+        {
+            joined += ';';
+        }
+        joined += value;
+    }
+    return joined;
+}
+
+static std::string_view statusName(BatchResult::Status status)
+{
+    switch (status)
+    {
+    case BatchResult::Status::Found:
+        return "found";
+    case BatchResult::Status::NotFound:
+        return "not_found";
+    case BatchResult::Status::Failed:
+        return "failed";
+    }
+    return "";
+}
+
+std::unique_ptr<OutputSink> OutputSink::create(const std::string &format, std::FILE *out)
+{
+    if (format == "ndjson")
+    {
+        return std::make_unique<NdjsonSink>(out);
+    }
+    if (format == "csv")
+    {
+        return std::make_unique<CsvSink>(out);
+    }
+    return nullptr;
+}
+
+OutputSink::OutputSink(std::FILE *out) : out(out)
+{
+    buffer.reserve(BUFFER_CAPACITY);
+    flusher = std::thread(&OutputSink::flushPending, this);
+}
+
+OutputSink::~OutputSink()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeFlusher.notify_one();
+    flusher.join();
+    flush();
+}
+
+void OutputSink::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    writeOut();
+}
+
+void OutputSink::writeOut()
+{
+    if (!buffer.empty())
+    {
+        std::fwrite(buffer.data(), 1, buffer.size(), out);
+        buffer.clear();
+    }
+    std::fflush(out);
+}
+
+void OutputSink::recordWritten(bool first)
+{
+    if (buffer.size() >= FLUSH_THRESHOLD)
+    {
+        writeOut();
+    }
+    else if (first)
+    {
+        pendingSince = std::chrono::steady_clock::now();
+        wakeFlusher.notify_one();
+    }
+}
+
+void OutputSink::flushPending()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping)
+    {
+        if (buffer.empty())
+        {
+            wakeFlusher.wait(lock);
+        }
+        else if (std::chrono::steady_clock::now() >= pendingSince + MAX_PENDING)
+        {
+            writeOut();
+        }
+        else
+        {
+            wakeFlusher.wait_until(lock, pendingSince + MAX_PENDING);
+        }
+    }
+}
+
+void OutputSink::appendNumber(uint64_t value)
+{
+    char digits[20];
+    auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    buffer.append(digits, end - digits);
+}
+
+void OutputSink::write(const BatchResult &result)
+{
+    // Both lookup sources share one schema so CSV columns stay stable
+    bool found = result.status == BatchResult::Status::Found;
+    bool steam = found && result.fromSteamApi;
+    bool scraped = found && !result.fromSteamApi;
+    std::lock_guard<std::mutex> lock(mutex);
+    bool first = buffer.empty();
+    const SteamGameInfo &info = result.steamInfo;
+    const GameData &data = result.gameData;
+
+    // Pick the value of whichever source produced the result, without copying it
+    auto pick = [steam, scraped](std::string_view steamValue, std::string_view scrapedValue)
+    {
+        return steam ? steamValue : scraped ? scrapedValue : std::string_view();
+    };
+
+    beginRecord("game");
+    numberField("index", result.index);
+    stringField("input", result.input);
+    stringField("status", statusName(result.status));
+    stringField("source", pick("steam", "steamdb"));
+    stringField("app_id", pick(info.appId, data.appId));
+    stringField("name", pick(info.name, data.name));
+    boolField("is_free", steam && info.isFree);
+    stringField("price", pick(info.price, data.currentPrice));
+    stringField("original_price", pick(info.originalPrice, ""));
+    stringField("discount_percent", pick(info.discountPercent, ""));
+    stringField("currency", pick(info.currency, ""));
+    stringField("lowest_price", pick("", data.lowestPrice));
+    stringField("release_date", pick(info.releaseDate, data.releaseDate));
+    stringField("developer", pick(info.developer, ""));
+    stringField("publisher", pick(info.publisher, ""));
+    stringField("metacritic", pick(info.metacriticScore, data.metacritic));
+    stringField("reviews", pick(info.userReviews, data.reviewScore));
+    stringField("tags", found ? joinList(result.fromSteamApi ? info.genres : data.tags) : std::string());
+    stringField("description", pick(info.description, data.description));
+    stringField("error", result.error);
+    endRecord();
+    recordWritten(first);
+}
+
+void OutputSink::write(const SteamSaleInfo &sale)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    bool first = buffer.empty();
+    beginRecord("sale");
+    stringField("app_id", sale.appId);
+    stringField("name", sale.name);
+    stringField("price", sale.currentPrice);
+    stringField("original_price", sale.originalPrice);
+    stringField("discount_percent", sale.discountPercent);
+    stringField("currency", sale.currency);
+    stringField("sale_end_date", sale.saleEndDate);
+    boolField("highlighted", sale.isHighlighted);
+    endRecord();
+    recordWritten(first);
+}
+
+NdjsonSink::NdjsonSink(std::FILE *out) : OutputSink(out)
+{
+}
+
+void NdjsonSink::beginRecord(std::string_view)
+{
+    buffer += '{';
+    firstField = true;
+}
+
+void NdjsonSink::appendName(std::string_view name)
+{
+    if (!firstField)
+    {
+        buffer += ',';
+    }
+    firstField = false;
+    buffer += '"';
+    buffer += name;
+    buffer += "\":";
+}
+
+void NdjsonSink::appendString(std::string_view value)
+{
+    static const char HEX[] = "0123456789abcdef";
+    buffer += '"';
+    size_t runStart = 0;
+    for (size_t i = 0; i < value.size(); ++i)
+    {
+        unsigned char c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\')
+        {
+            continue;
+        }
+        // Copy the clean run in one go, then the escape
+        buffer.append(value.data() + runStart, i - runStart);
+        runStart = i + 1;
+        switch (c)
+        {
+        case '"':
+            buffer += "\\\"";
+            break;
+        case '\\':
+            buffer += "\\\\";
+            break;
+        case '\n':
+            buffer += "\\n";
+            break;
+        case '\r':
+            buffer += "\\r";
+            break;
+        case '\t':
+            buffer += "\\t";
+            break;
+        default:
+            buffer += "\\u00";
+            buffer += HEX[c >> 4];
+            buffer += HEX[c & 0xF];
+            break;
+        }
+    }
+    buffer.append(value.data() + runStart, value.size() - runStart);
+    buffer += '"';
+}
+
+void NdjsonSink::stringField(std::string_view name, std::string_view value)
+{
+    appendName(name);
+    appendString(value);
+}
+
+void NdjsonSink::numberField(std::string_view name, uint64_t value)
+{
+    appendName(name);
+    appendNumber(value);
+}
+
+void NdjsonSink::boolField(std::string_view name, bool value)
+{
+    appendName(name);
+    buffer += value ? "true" : "false";
+}
+
+void NdjsonSink::endRecord()
+{
+    buffer += "}\n";
+}
+
+CsvSink::CsvSink(std::FILE *out) : OutputSink(out)
+{
+}
+
+void CsvSink::beginRecord(std::string_view kind)
+{
+    if (kind != currentKind)
+    {
+        currentKind = kind;
+        header.clear();
+        headerPending = true;
+    }
+    recordStart = buffer.size();
+    firstField = true;
+}
+
+void CsvSink::separate(std::string_view name)
+{
+    if (!firstField)
+    {
+        buffer += ',';
+        if (headerPending)
+        {
+            header += ',';
+        }
+    }
+    firstField = false;
+    if (headerPending)
+    {
+        header += name;
+    }
+}
+
+void CsvSink::appendCell(std::string_view value)
+{
+    if (value.find_first_of(",\"\r\n") == std::string_view::npos)
+    {
+        buffer += value;
+        return;
+    }
+    buffer += '"';
+    size_t runStart = 0;
+    for (size_t quote = value.find('"'); quote != std::string_view::npos; quote = value.find('"', quote + 1))
+    {
+        buffer.append(value.data() + runStart, quote + 1 - runStart);
+        buffer += '"';
+        runStart = quote + 1;
+    }
+    buffer.append(value.data() + runStart, value.size() - runStart);
+    buffer += '"';
+}
+
+void CsvSink::stringField(std::string_view name, std::string_view value)
+{
+    separate(name);
+    appendCell(value);
+}
+
+void CsvSink::numberField(std::string_view name, uint64_t value)
+{
+    separate(name);
+    appendNumber(value);
+}
+
+void CsvSink::boolField(std::string_view name, bool value)
+{
+    separate(name);
+    buffer += value ? "true" : "false";
+}
+
+void CsvSink::endRecord()
+{
+    buffer += "\r\n";
+    if (headerPending)
+    {
+        // The column names are only known once the first record of a schema is written
+        header += "\r\n";
+        buffer.insert(recordStart, header);
+        headerPending = false;
+    }
+}
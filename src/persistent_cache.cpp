@@ -0,0 +1,485 @@
+#include "persistent_cache.h"
+#include "config.h"
+#include "tracer.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static const char FILE_MAGIC[4] = {'S', 'D', 'B', 'C'};
+
+// Key prefixes separating the record kinds
+static const char KIND_GAME = 'G';
+static const char KIND_GAME_INFO = 'I';
+static const char KIND_SALE_INFO = 'S';
+
+// Append helpers for the binary record format
+static void appendU32(std::string &out, uint32_t value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+static void appendI64(std::string &out, int64_t value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+static void appendString(std::string &out, const std::string &value)
+{
+    appendU32(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+static void appendList(std::string &out, const std::vector<std::string> &values)
+{
+    appendU32(out, static_cast<uint32_t>(values.size()));
+    for (const auto &value : values)
+    {
+        appendString(out, value);
+    }
+}
+
+static void appendBool(std::string &out, bool value)
+{
+    out += static_cast<char>(value ? 1 : 0);
+}
+
+// Bounds-checked reader over one record; ok turns false on truncated input
+struct RecordReader
+{
+    std::string_view in;
+    size_t pos = 0;
+    bool ok = true;
+
+    explicit RecordReader(std::string_view in) : in(in) {}
+
+    template <typename T>
+    T readRaw()
+    {
+        T value{};
+        if (!ok || in.size() - pos < sizeof(T))
+        {
+            ok = false;
+            return value;
+        }
+        std::memcpy(&value, in.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::string_view readView()
+    {
+        uint32_t length = readRaw<uint32_t>();
+        if (!ok || in.size() - pos < length)
+        {
+            ok = false;
+            return std::string_view();
+        }
+        std::string_view value = in.substr(pos, length);
+        pos += length;
+        return value;
+    }
+
+    void read(std::string &out) { out.assign(readView()); }
+
+    void read(bool &out) { out = readRaw<uint8_t>() != 0; }
+
+    void read(std::vector<std::string> &out)
+    {
+        uint32_t count = readRaw<uint32_t>();
+        out.clear();
+        for (uint32_t i = 0; ok && i < count; ++i)
+        {
+            out.emplace_back(readView());
+        }
+    }
+};
+
+static std::string encode(const GameData &data)
+{
+    std::string out;
+    appendString(out, data.name);
+    appendString(out, data.appId);
+    appendString(out, data.currentPrice);
+    appendString(out, data.lowestPrice);
+    appendString(out, data.metacritic);
+    appendString(out, data.releaseDate);
+    appendList(out, data.tags);
+    appendString(out, data.description);
+    appendString(out, data.reviewScore);
+    return out;
+}
+
+static bool decode(std::string_view payload, GameData &data)
+{
+    RecordReader reader(payload);
+    reader.read(data.name);
+    reader.read(data.appId);
+    reader.read(data.currentPrice);
+    reader.read(data.lowestPrice);
+    reader.read(data.metacritic);
+    reader.read(data.releaseDate);
+    reader.read(data.tags);
+    reader.read(data.description);
+    reader.read(data.reviewScore);
+    return reader.ok;
+}
+
+static std::string encode(const SteamGameInfo &info)
+{
+    std::string out;
+    appendString(out, info.appId);
+    appendString(out, info.name);
+    appendString(out, info.developer);
+    appendString(out, info.publisher);
+    appendString(out, info.releaseDate);
+    appendString(out, info.description);
+    appendString(out, info.price);
+    appendString(out, info.currency);
+    appendBool(out, info.isFree);
+    appendBool(out, info.isOnSale);
+    appendString(out, info.originalPrice);
+    appendString(out, info.discountPercent);
+    appendString(out, info.saleEndDate);
+    appendList(out, info.categories);
+    appendList(out, info.genres);
+    appendString(out, info.headerImage);
+    appendString(out, info.metacriticScore);
+    appendString(out, info.userReviews);
+    return out;
+}
+
+static bool decode(std::string_view payload, SteamGameInfo &info)
+{
+    RecordReader reader(payload);
+    reader.read(info.appId);
+    reader.read(info.name);
+    reader.read(info.developer);
+    reader.read(info.publisher);
+    reader.read(info.releaseDate);
+    reader.read(info.description);
+    reader.read(info.price);
+    reader.read(info.currency);
+    reader.read(info.isFree);
+    reader.read(info.isOnSale);
+    reader.read(info.originalPrice);
+    reader.read(info.discountPercent);
+    reader.read(info.saleEndDate);
+    reader.read(info.categories);
+    reader.read(info.genres);
+    reader.read(info.headerImage);
+    reader.read(info.metacriticScore);
+    reader.read(info.userReviews);
+    return reader.ok;
+}
+
+static std::string encode(const SteamSaleInfo &info)
+{
+    std::string out;
+    appendString(out, info.appId);
+    appendString(out, info.name);
+    appendString(out, info.currentPrice);
+    appendString(out, info.originalPrice);
+    appendString(out, info.discountPercent);
+    appendString(out, info.currency);
+    appendString(out, info.saleEndDate);
+    appendString(out, info.headerImage);
+    appendBool(out, info.isHighlighted);
+    return out;
+}
+
+static bool decode(std::string_view payload, SteamSaleInfo &info)
+{
+    RecordReader reader(payload);
+    reader.read(info.appId);
+    reader.read(info.name);
+    reader.read(info.currentPrice);
+    reader.read(info.originalPrice);
+    reader.read(info.discountPercent);
+    reader.read(info.currency);
+    reader.read(info.saleEndDate);
+    reader.read(info.headerImage);
+    reader.read(info.isHighlighted);
+    return reader.ok;
+}
+
+static int64_t currentTime()
+{
+    return static_cast<int64_t>(std::time(nullptr));
+}
+
+PersistentCache::PersistentCache() : enabled(false), ttlSeconds(24 * 3600), dirtyCount(0)
+{
+}
+
+PersistentCache::~PersistentCache()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (dirtyCount > 0)
+    {
+        flushLocked();
+    }
+}
+
+PersistentCache &PersistentCache::getInstance()
+{
+    static PersistentCache instance;
+    return instance;
+}
+
+void PersistentCache::open(const std::string &path)
+{
+    Config &config = Config::getInstance();
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    filePath = path;
+    enabled = config.get("ENABLE_CACHING") != "false";
+    try
+    {
+        std::string hours = config.get("CACHE_EXPIRY_HOURS");
+        ttlSeconds = hours.empty() ? 24 * 3600 : static_cast<int64_t>(std::stoi(hours)) * 3600;
+    }
+    catch (const std::exception &)
+    {
+        ttlSeconds = 24 * 3600;
+    }
+
+    entries.clear();
+    dirtyCount = 0;
+    if (enabled && mappedFile.open(filePath))
+    {
+        loadIndex();
+    }
+}
+
+bool PersistentCache::isEnabled() const
+{
+    return enabled;
+}
+
+void PersistentCache::loadIndex()
+{
+    std::string_view file = mappedFile.view();
+    RecordReader reader(file);
+    char magic[4];
+    for (char &c : magic)
+    {
+        c = reader.readRaw<char>();
+    }
+    uint32_t version = reader.readRaw<uint32_t>();
+    uint32_t count = reader.readRaw<uint32_t>();
+    if (!reader.ok || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0 || version != FILE_VERSION)
+    {
+        std::cerr << "Warning: Ignoring unrecognized cache file: " << filePath << std::endl;
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t length = reader.readRaw<uint32_t>();
+        if (!reader.ok || file.size() - reader.pos < length)
+        {
+            std::cerr << "Warning: Cache file is truncated: " << filePath << std::endl;
+            break;
+        }
+
+        RecordReader record(file.substr(reader.pos, length));
+        reader.pos += length;
+        int64_t storedAt = record.readRaw<int64_t>();
+        std::string_view key = record.readView();
+        if (!record.ok)
+        {
+            continue;
+        }
+
+        Entry &entry = entries[std::string(key)];
+        entry.storedAt = storedAt;
+        entry.mapped = true;
+        entry.mappedPayload = record.in.substr(record.pos);
+        entry.ownedPayload.clear();
+    }
+}
+
+bool PersistentCache::findPayload(const std::string &key, std::string_view &payload)
+{
+    if (!enabled)
+    {
+        return false;
+    }
+    auto it = entries.find(key);
+    if (it == entries.end() || currentTime() - it->second.storedAt > ttlSeconds)
+    {
+        return false;
+    }
+    payload = it->second.payload();
+    return true;
+}
+
+void PersistentCache::insert(const std::string &key, std::string payload)
+{
+    Entry &entry = entries[key];
+    entry.storedAt = currentTime();
+    entry.mapped = false;
+    entry.mappedPayload = std::string_view();
+    entry.ownedPayload = std::move(payload);
+
+    if (++dirtyCount >= FLUSH_EVERY)
+    {
+        flushLocked();
+    }
+}
+
+bool PersistentCache::loadGame(const std::string &gameName, GameData &out)
+{
+    TRACE_SCOPE("PersistentCache::loadGame", "cache", gameName);
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    std::string_view payload;
+    return findPayload(KIND_GAME + gameName, payload) && decode(payload, out);
+}
+
+void PersistentCache::storeGame(const std::string &gameName, const GameData &data)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (enabled)
+    {
+        insert(KIND_GAME + gameName, encode(data));
+    }
+}
+
+bool PersistentCache::loadGameInfo(const std::string &appId, SteamGameInfo &out)
+{
+    TRACE_SCOPE("PersistentCache::loadGameInfo", "cache", appId);
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    std::string_view payload;
+    return findPayload(KIND_GAME_INFO + appId, payload) && decode(payload, out);
+}
+
+void PersistentCache::storeGameInfo(const SteamGameInfo &info)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (enabled)
+    {
+        insert(KIND_GAME_INFO + info.appId, encode(info));
+    }
+}
+
+bool PersistentCache::loadSaleInfo(const std::string &appId, SteamSaleInfo &out, const std::string &countryCode)
+{
+    TRACE_SCOPE("PersistentCache::loadSaleInfo", "cache", appId);
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    std::string_view payload;
+    return findPayload(KIND_SALE_INFO + countryCode + ":" + appId, payload) && decode(payload, out);
+}
+
+void PersistentCache::storeSaleInfo(const SteamSaleInfo &info, const std::string &countryCode)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (enabled)
+    {
+        insert(KIND_SALE_INFO + countryCode + ":" + info.appId, encode(info));
+    }
+}
+
+void PersistentCache::flush()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    flushLocked();
+}
+
+void PersistentCache::flushLocked()
+{
+    if (!enabled || filePath.empty())
+    {
+        return;
+    }
+
+    // Serialize every live entry into the temp file
+    int64_t now = currentTime();
+    std::string buffer;
+    uint32_t count = 0;
+    buffer.append(FILE_MAGIC, sizeof(FILE_MAGIC));
+    appendU32(buffer, FILE_VERSION);
+    appendU32(buffer, 0); // Patched below
+    for (const auto &pair : entries)
+    {
+        const Entry &entry = pair.second;
+        if (now - entry.storedAt > ttlSeconds)
+        {
+            continue;
+        }
+        std::string_view payload = entry.payload();
+        uint32_t length = static_cast<uint32_t>(sizeof(int64_t) + sizeof(uint32_t) + pair.first.size() + payload.size());
+        appendU32(buffer, length);
+        appendI64(buffer, entry.storedAt);
+        appendString(buffer, pair.first);
+        buffer.append(payload);
+        ++count;
+    }
+    std::memcpy(&buffer[sizeof(FILE_MAGIC) + sizeof(uint32_t)], &count, sizeof(count));
+
+    std::string tempPath = filePath + ".tmp";
+    FILE *out = std::fopen(tempPath.c_str(), "wb");
+    if (!out)
+    {
+        std::cerr << "Warning: Unable to write cache file: " << tempPath << std::endl;
+        return;
+    }
+    bool written = std::fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size() && std::fflush(out) == 0;
+#ifdef _WIN32
+    written = written && _commit(_fileno(out)) == 0;
+#else
+    written = written && fsync(fileno(out)) == 0;
+#endif
+    written = (std::fclose(out) == 0) && written;
+    if (!written)
+    {
+        std::cerr << "Warning: Unable to write cache file: " << tempPath << std::endl;
+        std::remove(tempPath.c_str());
+        return;
+    }
+
+    // Keep unflushed entries so they survive a failed rename
+    std::unordered_map<std::string, Entry> owned;
+    for (auto &pair : entries)
+    {
+        if (!pair.second.mapped)
+        {
+            owned.emplace(pair.first, std::move(pair.second));
+        }
+    }
+
+    // The mapping must be released before the file can be replaced on Windows
+    entries.clear();
+    mappedFile.close();
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, filePath, ec);
+    if (ec)
+    {
+        std::cerr << "Warning: Unable to replace cache file: " << ec.message() << std::endl;
+        std::remove(tempPath.c_str());
+    }
+
+    if (mappedFile.open(filePath))
+    {
+        loadIndex();
+    }
+    if (ec)
+    {
+        for (auto &pair : owned)
+        {
+            entries[pair.first] = std::move(pair.second);
+        }
+    }
+    else
+    {
+        dirtyCount = 0;
+    }
+}
@@ -1,17 +1,167 @@
 #include "rate_limiter.h"
+#include "config.h"
+#include "connection_pool.h"
+#include <algorithm>
+#include <thread>
 
-// Constructor to initialize the rate limiter with a specific rate
-RateLimiter::RateLimiter(int requestsPerMinute) {
-    delay = std::chrono::milliseconds(60000 / requestsPerMinute);
-    lastRequest = std::chrono::steady_clock::now();
+// Throttling may slow a host down to this fraction of its configured rate
+static const int64_t MAX_SLOWDOWN = 32;
+
+// Successful responses needed to climb from a halved rate back to the configured one
+static const double RECOVERY_STEPS = 10.0;
+
+// Retry budget, in tenths of a retry: each request earns one tenth, so retries stay
+// around 10% of traffic once the initial allowance of 10 is spent
+static const int RETRY_COST = 10;
+static const int RETRY_BUDGET_INITIAL = 10 * RETRY_COST;
+static const int RETRY_BUDGET_MAX = 100 * RETRY_COST;
+
+static int64_t toTicks(RateLimiter::Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+void RateLimiter::Cell::configure(int requestsPerPeriod, std::chrono::nanoseconds period, int burst) {
+    if (requestsPerPeriod <= 0) {
+        baseInterval = 0;
+        tolerance = 0;
+    } else {
+        baseInterval = period.count() / requestsPerPeriod;
+        tolerance = baseInterval * (std::max(1, std::min(burst, requestsPerPeriod)) - 1);
+    }
+    interval.store(baseInterval, std::memory_order_relaxed);
+}
+
+int64_t RateLimiter::Cell::reserve(int64_t arrival) {
+    if (baseInterval == 0) {
+        return arrival;
+    }
+    int64_t step = interval.load(std::memory_order_relaxed);
+    int64_t tat = theoreticalArrival.load(std::memory_order_relaxed);
+    while (true) {
+        int64_t allowAt = std::max(arrival, tat - tolerance);
+        int64_t next = std::max(tat, allowAt) + step;
+        if (theoreticalArrival.compare_exchange_weak(tat, next, std::memory_order_relaxed)) {
+            return allowAt;
+        }
+    }
+}
+
+void RateLimiter::Cell::throttle(int64_t now, int64_t resumeAt) {
+    if (baseInterval == 0) {
+        return;
+    }
+
+    // Requests already in flight when the host pushed back report the same event,
+    // so only the first throttle in a window halves the rate
+    int64_t until = throttledUntil.load(std::memory_order_relaxed);
+    while (now >= until) {
+        int64_t current = interval.load(std::memory_order_relaxed);
+        int64_t next = std::min(current * 2, baseInterval * MAX_SLOWDOWN);
+        if (throttledUntil.compare_exchange_weak(until, std::max(resumeAt, now) + next, std::memory_order_relaxed)) {
+            while (!interval.compare_exchange_weak(current, std::min(current * 2, baseInterval * MAX_SLOWDOWN),
+                                                   std::memory_order_relaxed)) {
+            }
+            break;
+        }
+    }
+
+    // Push the arrival time past the burst tolerance so nothing is released before resumeAt
+    int64_t tat = theoreticalArrival.load(std::memory_order_relaxed);
+    while (tat < resumeAt + tolerance &&
+           !theoreticalArrival.compare_exchange_weak(tat, resumeAt + tolerance, std::memory_order_relaxed)) {
+    }
+}
+
+void RateLimiter::Cell::recover() {
+    if (baseInterval == 0) {
+        return;
+    }
+    int64_t current = interval.load(std::memory_order_relaxed);
+    while (current > baseInterval) {
+        // Rates add, intervals do not: 1/next = 1/current + 1/(base * steps)
+        double rate = 1.0 / double(current) + 1.0 / (double(baseInterval) * RECOVERY_STEPS);
+        int64_t next = std::max(baseInterval, static_cast<int64_t>(1.0 / rate));
+        if (interval.compare_exchange_weak(current, next, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+}
+
+RateLimiter::RateLimiter() : retryBudget(RETRY_BUDGET_INITIAL) {
+    // Steam Web API limits come straight from the documented config keys
+    addHost("api.steampowered.com", "API", 200, 10000, 10);
+    // The store API throttles at roughly 200 requests per 5 minutes
+    addHost("store.steampowered.com", "STORE", 40, 0, 5);
+    // Keep scraping steamdb.info polite: one page every two seconds
+    addHost("steamdb.info", "SCRAPER", 30, 0, 1);
+}
+
+RateLimiter& RateLimiter::getInstance() {
+    static RateLimiter instance;
+    return instance;
+}
+
+void RateLimiter::addHost(const std::string& host, const std::string& prefix, int perMinute, int perHour, int burst) {
+    auto bucket = std::make_unique<Bucket>();
+    Config& config = Config::getInstance();
+    int burstSize = static_cast<int>(config.getInt(prefix + "_RATE_BURST", burst));
+    bucket->perMinute.configure(static_cast<int>(config.getInt(prefix + "_RATE_LIMIT_PER_MINUTE", perMinute)),
+                                std::chrono::minutes(1), burstSize);
+    bucket->perHour.configure(static_cast<int>(config.getInt(prefix + "_RATE_LIMIT_PER_HOUR", perHour)),
+                              std::chrono::hours(1), burstSize);
+    buckets[host] = std::move(bucket);
+}
+
+RateLimiter::Bucket* RateLimiter::findBucket(const std::string& url) {
+    auto it = buckets.find(ConnectionPool::hostFromUrl(url));
+    return it == buckets.end() ? nullptr : it->second.get();
+}
+
+RateLimiter::Clock::time_point RateLimiter::reserve(const std::string& url, Clock::time_point earliest) {
+    Bucket* bucket = findBucket(url);
+    if (!bucket) {
+        return earliest;
+    }
+
+    // Take the hourly slot first, then the per-minute slot no earlier than it,
+    // so a request held back by the hourly limit does not burn minute permits early
+    int64_t arrival = toTicks(earliest);
+    arrival = bucket->perHour.reserve(arrival);
+    arrival = bucket->perMinute.reserve(arrival);
+    return Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(arrival)));
+}
+
+void RateLimiter::acquire(const std::string& url) {
+    std::this_thread::sleep_until(reserve(url));
+}
+
+void RateLimiter::recordResponse(const std::string& url, long status, std::chrono::seconds retryAfter) {
+    Bucket* bucket = findBucket(url);
+    if (!bucket) {
+        return;
+    }
+    if (status == 429 || status == 503) {
+        Clock::time_point now = Clock::now();
+        bucket->perMinute.throttle(toTicks(now), toTicks(now + retryAfter));
+    } else if (status >= 200 && status < 400) {
+        // Other 4xx (such as a 403 block) and 5xx are no sign the host has capacity to spare
+        bucket->perMinute.recover();
+    }
+}
+
+void RateLimiter::recordRequest() {
+    int budget = retryBudget.load(std::memory_order_relaxed);
+    while (budget < RETRY_BUDGET_MAX &&
+           !retryBudget.compare_exchange_weak(budget, budget + 1, std::memory_order_relaxed)) {
+    }
 }
 
-// Wait for the next allowed request time
-void RateLimiter::waitForNext() {
-    auto now = std::chrono::steady_clock::now();
-    auto timeSinceLastRequest = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastRequest);
-    if (timeSinceLastRequest < delay) {
-        std::this_thread::sleep_for(delay - timeSinceLastRequest);
+bool RateLimiter::tryRetry() {
+    int budget = retryBudget.load(std::memory_order_relaxed);
+    while (budget >= RETRY_COST) {
+        if (retryBudget.compare_exchange_weak(budget, budget - RETRY_COST, std::memory_order_relaxed)) {
+            return true;
+        }
     }
-    lastRequest = std::chrono::steady_clock::now();
+    return false;
 }
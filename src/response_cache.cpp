@@ -0,0 +1,133 @@
+#include "response_cache.h"
+#include "config.h"
+#include "tracer.h"
+#include <algorithm>
+#include <cctype>
+
+// Freshness given to responses that carry no max-age
+static const long long DEFAULT_TTL_SECONDS = 300;
+
+static const long long DEFAULT_MEMORY_MB = 32;
+
+ResponseCache::ResponseCache()
+    : defaultTtl(std::max(0LL, Config::getInstance().getInt("HTTP_CACHE_TTL_SECONDS", DEFAULT_TTL_SECONDS))),
+      maxBytes(static_cast<size_t>(std::max(0LL, Config::getInstance().getInt("HTTP_CACHE_MEMORY_MB", DEFAULT_MEMORY_MB))) * 1024 * 1024),
+      usedBytes(0)
+{
+}
+
+ResponseCache &ResponseCache::getInstance()
+{
+    static ResponseCache instance;
+    return instance;
+}
+
+std::shared_ptr<const ResponseCache::Entry> ResponseCache::find(const std::string &key)
+{
+    TRACE_SCOPE("ResponseCache::find", "cache", key);
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = entries.find(key);
+    if (it == entries.end())
+    {
+        return nullptr;
+    }
+    recentKeys.splice(recentKeys.begin(), recentKeys, it->second.recent);
+    return it->second.entry;
+}
+
+std::shared_ptr<const ResponseCache::Entry> ResponseCache::store(const std::string &key, const std::string &body,
+                                                                 const std::string &cacheControl,
+                                                                 const std::string &etag,
+                                                                 const std::string &lastModified)
+{
+    long long freshness = freshnessSeconds(cacheControl);
+    if (maxBytes == 0 || freshness < 0 || (freshness == 0 && etag.empty() && lastModified.empty()) ||
+        body.size() > maxBytes / 4)
+    {
+        return nullptr;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->body = std::make_shared<const std::string>(body);
+    entry->etag = etag;
+    entry->lastModified = lastModified;
+    entry->freshUntil = Clock::now() + std::chrono::seconds(freshness);
+    put(key, entry);
+    return entry;
+}
+
+std::shared_ptr<const ResponseCache::Entry> ResponseCache::refresh(const std::string &key,
+                                                                   const std::shared_ptr<const Entry> &entry,
+                                                                   const std::string &cacheControl,
+                                                                   const std::string &etag,
+                                                                   const std::string &lastModified)
+{
+    long long freshness = std::max(0LL, freshnessSeconds(cacheControl));
+    auto renewed = std::make_shared<Entry>(*entry);
+    if (!etag.empty())
+    {
+        renewed->etag = etag;
+    }
+    if (!lastModified.empty())
+    {
+        renewed->lastModified = lastModified;
+    }
+    renewed->freshUntil = Clock::now() + std::chrono::seconds(freshness);
+    put(key, renewed);
+    return renewed;
+}
+
+long long ResponseCache::freshnessSeconds(const std::string &cacheControl) const
+{
+    std::string directives = cacheControl;
+    std::transform(directives.begin(), directives.end(), directives.begin(), [](unsigned char c)
+                   { return static_cast<char>(std::tolower(c)); });
+
+    if (directives.find("no-store") != std::string::npos)
+    {
+        return -1;
+    }
+    if (directives.find("no-cache") != std::string::npos)
+    {
+        return 0;
+    }
+    size_t maxAge = directives.find("max-age=");
+    if (maxAge != std::string::npos)
+    {
+        try
+        {
+            return std::max(0LL, std::stoll(directives.substr(maxAge + 8)));
+        }
+        catch (const std::exception &)
+        {
+            return 0;
+        }
+    }
+    return defaultTtl.count();
+}
+
+void ResponseCache::put(const std::string &key, std::shared_ptr<const Entry> entry)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = entries.find(key);
+    if (it != entries.end())
+    {
+        usedBytes -= it->second.entry->body->size() + key.size();
+        it->second.entry = std::move(entry);
+        recentKeys.splice(recentKeys.begin(), recentKeys, it->second.recent);
+    }
+    else
+    {
+        recentKeys.push_front(key);
+        it = entries.emplace(key, Slot{std::move(entry), recentKeys.begin()}).first;
+    }
+    usedBytes += it->second.entry->body->size() + key.size();
+
+    while (usedBytes > maxBytes && recentKeys.size() > 1)
+    {
+        auto oldest = entries.find(recentKeys.back());
+        usedBytes -= oldest->second.entry->body->size() + oldest->first.size();
+        entries.erase(oldest);
+        recentKeys.pop_back();
+    }
+}
@@ -1,68 +1,51 @@
 #include "scraper.h"
 #include "network_utils.h"
-#include <curl/curl.h>
-#include <regex>
+#include "html_scanner.h"
+#include "steamdb_patterns.h"
+#include "tracer.h"
+#include <string_view>
+#include <vector>
 #include "error_handling.h"
 
-// Callback function to write data received from the server to a string
-static size_t WriteCallback(void *contents, size_t size, size_t nmemb, void *userp)
-{
-    ((std::string *)userp)->append((char *)contents, size * nmemb);
-    return size * nmemb;
-}
+// Once this many bytes follow the last tag without another one, the tag list is complete
+static const size_t TAG_LIST_GAP = 4096;
 
-// Constructor to initialize the scraper and rate limiter
-Scraper::Scraper() : rateLimiter(std::make_unique<RateLimiter>())
-{
-    curl_global_init(CURL_GLOBAL_DEFAULT);
-}
+// Constructor to initialize the scraper
+Scraper::Scraper() = default;
 
 // Destructor to clean up resources
-Scraper::~Scraper()
-{
-    curl_global_cleanup();
-}
+Scraper::~Scraper() = default;
 
-// Fetch the HTML content of a web page
-std::string Scraper::fetchPage(const std::string &url)
+// Fetch a page incrementally (rate limited per host by the network layer)
+std::string Scraper::fetchPage(const std::string &url, const NetworkUtils::StreamCallback &onData)
 {
-    rateLimiter->waitForNext();
-
-    CURL *curl = curl_easy_init();
-    std::string readBuffer;
-
-    if (curl)
-    {
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, "SteamDB CLI/1.0");
-
-        CURLcode res = curl_easy_perform(curl);
-        curl_easy_cleanup(curl);
-
-        if (res != CURLE_OK)
-        {
-            throw NetworkError("Failed to fetch page: " + std::string(curl_easy_strerror(res)));
-        }
-    }
-    else
-    {
-        throw NetworkError("Failed to initialize CURL");
-    }
-
-    return readBuffer;
+    return NetworkUtils::fetchStreaming(url, onData).body;
 }
 
 // Search for a game by name and return its data
 GameData Scraper::searchGame(const std::string &gameName)
 {
+    TRACE_SCOPE("searchGame", "scrape", gameName);
     std::string baseUrl = "https://steamdb.info/search/";
     std::string url = baseUrl + "?term=" + NetworkUtils::urlEncode(gameName);
+    GameData gameData;
     std::string page;
     try
     {
-        page = fetchPage(url);
+        // Only the first result row is used, so stop downloading as soon as it is complete
+        HtmlScanner::Matcher resultRow(SteamdbPatterns::RESULT_ROW);
+        std::vector<std::string_view> captures;
+        page = fetchPage(url, [&](const std::string &received)
+                         {
+                             TRACE_SCOPE("scan search results", "parse");
+                             if (!resultRow.next(received, captures))
+                             {
+                                 return true;
+                             }
+                             gameData.appId = std::string(captures[0]);
+                             gameData.name = std::string(captures[1]);
+                             gameData.releaseDate = std::string(captures[2]);
+                             return false; });
     }
     catch (const NetworkError &e)
     {
@@ -72,101 +55,93 @@ GameData Scraper::searchGame(const std::string &gameName)
     {
         throw std::runtime_error("Unexpected error while searching for game: " + gameName + ". " + e.what());
     }
-    return parseGameData(page);
+
+    if (gameData.appId.empty())
+    {
+        reportSearchFailure(page);
+    }
+    parseGameDetails(gameData);
+    return gameData;
 }
 
-// Parse the HTML content to extract game data
-GameData Scraper::parseGameData(const std::string &html)
+void Scraper::reportSearchFailure(const std::string &html)
 {
-    GameData gameData;
-
+    TRACE_SCOPE("reportSearchFailure", "parse");
     // Check if search returned any results
     if (html.find("No results found") != std::string::npos)
     {
         throw std::runtime_error("No games found matching the search criteria");
     }
 
-    // Extract from search results table
-    std::regex tableRowRegex("<tr[^>]*data-appid=\"(\\d+)\"[^>]*>\\s*"
-                             "<td[^>]*>.*?</td>\\s*"                  // Type column
-                             "<td[^>]*><a[^>]*>(.*?)</a>.*?</td>\\s*" // Name column
-                             "<td[^>]*>(.*?)</td>");                  // Release date column
-
-    std::smatch tableMatch;
-    if (std::regex_search(html, tableMatch, tableRowRegex))
+    // Detailed error handling for parsing failures
+    HtmlScanner::Matcher errorBox(SteamdbPatterns::ERROR_BOX);
+    std::vector<std::string_view> captures;
+    if (errorBox.next(html, captures))
     {
-        gameData.appId = tableMatch[1].str();
-        gameData.name = tableMatch[2].str();
-        gameData.releaseDate = tableMatch[3].str();
+        throw ParsingError("Parsing error: " + std::string(captures[0]));
+    }
+    throw ParsingError("Could not parse search results. HTML content may have changed.");
+}
 
-        // Fetch detailed page for the game
-        std::string detailUrl = "https://steamdb.info/app/" + gameData.appId + "/";
-        try
+void Scraper::parseGameDetails(GameData &gameData)
+{
+    TRACE_SCOPE("parseGameDetails", "scrape", gameData.appId);
+    HtmlScanner::Matcher price(SteamdbPatterns::CURRENT_PRICE);
+    HtmlScanner::Matcher lowestPrice(SteamdbPatterns::LOWEST_PRICE);
+    HtmlScanner::Matcher review(SteamdbPatterns::USER_REVIEWS);
+    HtmlScanner::Matcher metacritic(SteamdbPatterns::METACRITIC);
+    HtmlScanner::Matcher tag(SteamdbPatterns::APP_TAG);
+    bool havePrice = false;
+    bool haveLowestPrice = false;
+    bool haveReview = false;
+    bool haveMetacritic = false;
+    std::vector<std::string_view> captures;
+
+    // Each field is taken as soon as its cells are complete; the download stops once
+    // every field has been seen and the tag list has ended
+    auto onData = [&](const std::string &received)
+    {
+        TRACE_SCOPE("scan game details", "parse");
+        if (!havePrice && price.next(received, captures))
         {
-            std::string detailPage = fetchPage(detailUrl);
-
-            // Extract price
-            std::regex priceRegex("<td[^>]*>Current Price:</td>\\s*<td[^>]*>(.*?)</td>");
-            std::smatch priceMatch;
-            if (std::regex_search(detailPage, priceMatch, priceRegex))
-            {
-                gameData.currentPrice = priceMatch[1].str();
-            }
-
-            // Extract lowest price
-            std::regex lowestPriceRegex("<td[^>]*>Lowest Price:</td>\\s*<td[^>]*>(.*?)</td>");
-            std::smatch lowestMatch;
-            if (std::regex_search(detailPage, lowestMatch, lowestPriceRegex))
-            {
-                gameData.lowestPrice = lowestMatch[1].str();
-            }
-
-            // Extract Metacritic score
-            std::regex metacriticRegex("Metacritic Score:</td>\\s*<td[^>]*><a[^>]*>(\\d+)</a>");
-            std::smatch metacriticMatch;
-            if (std::regex_search(detailPage, metacriticMatch, metacriticRegex))
-            {
-                gameData.metacritic = metacriticMatch[1].str();
-            }
-
-            // Extract tags
-            std::regex tagsRegex("<a[^>]*class=\"app-tag\"[^>]*>(.*?)</a>");
-            std::smatch tagsMatch;
-            std::string::const_iterator searchStart(detailPage.cbegin());
-            while (std::regex_search(searchStart, detailPage.cend(), tagsMatch, tagsRegex))
-            {
-                gameData.tags.push_back(tagsMatch[1].str());
-                searchStart = tagsMatch.suffix().first;
-            }
-
-            // Extract review score
-            std::regex reviewRegex("User Reviews:</td>\\s*<td[^>]*>(.*?)</td>");
-            std::smatch reviewMatch;
-            if (std::regex_search(detailPage, reviewMatch, reviewRegex))
-            {
-                gameData.reviewScore = reviewMatch[1].str();
-            }
+            gameData.currentPrice = std::string(captures[0]);
+            havePrice = true;
         }
-        catch (const std::exception &e)
+        if (!haveLowestPrice && lowestPrice.next(received, captures))
         {
-            // If detail page fails, we still return basic info from search
-            std::cerr << "Warning: Could not fetch detailed information: " << e.what() << std::endl;
+            gameData.lowestPrice = std::string(captures[0]);
+            haveLowestPrice = true;
         }
-    }
-    else
-    {
-        // Detailed error handling for parsing failures
-        std::regex errorRegex("<div[^>]*class=\"error\"[^>]*>(.*?)</div>");
-        std::smatch errorMatch;
-        if (std::regex_search(html, errorMatch, errorRegex))
+        if (!haveReview && review.next(received, captures))
         {
-            throw ParsingError("Parsing error: " + errorMatch[1].str());
+            gameData.reviewScore = std::string(captures[0]);
+            haveReview = true;
         }
-        else
+        while (!haveMetacritic && metacritic.next(received, captures))
         {
-            throw ParsingError("Could not parse search results. HTML content may have changed.");
+            if (SteamdbPatterns::isScore(captures[0]))
+            {
+                gameData.metacritic = std::string(captures[0]);
+                haveMetacritic = true;
+            }
         }
-    }
+        while (tag.next(received, captures))
+        {
+            gameData.tags.push_back(std::string(captures[0]));
+        }
+        bool tagsDone = !gameData.tags.empty() && received.size() - tag.end() > TAG_LIST_GAP;
+        return !(havePrice && haveLowestPrice && haveReview && haveMetacritic && tagsDone);
+    };
 
-    return gameData;
+    // Fetch detailed page for the game
+    std::string detailUrl = "https://steamdb.info/app/" + gameData.appId + "/";
+    try
+    {
+        fetchPage(detailUrl, onData);
+    }
+    catch (const std::exception &e)
+    {
+        // If detail page fails, we still return basic info from search
+        std::cerr << "Warning: Could not fetch detailed information: " << e.what() << std::endl;
+    }
 }
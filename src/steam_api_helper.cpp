@@ -2,13 +2,347 @@
 #include "network_utils.h"
 #include "config.h"
 #include "logger.h"
+#include "json_reader.h"
+#include "persistent_cache.h"
+#include "catalog_index.h"
+#include "fuzzy_index.h"
+#include "tracer.h"
 #include <chrono>
 #include <thread>
 #include <algorithm>
 #include <sstream>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <cstdlib>
 #include <cctype>
+#include <mutex>
+
+// Position the reader on the "data" object of one app in an appdetails response
+static bool findAppData(JsonReader &reader, const std::string &appId)
+{
+    std::string_view key;
+    if (!reader.beginObject())
+    {
+        return false;
+    }
+    while (reader.nextKey(key))
+    {
+        if (key != appId || !reader.beginObject())
+        {
+            reader.skipValue();
+            continue;
+        }
+        while (reader.nextKey(key))
+        {
+            if (key == "data" && reader.peek() == JsonReader::Type::Object)
+            {
+                return true;
+            }
+            reader.skipValue();
+        }
+    }
+    return false;
+}
+
+// Read a JSON array of strings and join them with ", "
+static std::string readJoinedStrings(JsonReader &reader)
+{
+    std::string joined;
+    std::string item;
+    if (!reader.beginArray())
+    {
+        reader.readScalar(joined);
+        return joined;
+    }
+    while (reader.nextElement())
+    {
+        reader.readScalar(item);
+        if (!item.empty())
+        {
+            if (!joined.empty())
+            {
+                joined += ", ";
+            }
+            joined += item;
+        }
+    }
+    return joined;
+}
+
+// Read one named member of the object at the reader's position as a scalar
+static std::string readMember(JsonReader &reader, std::string_view member)
+{
+    std::string value;
+    std::string_view key;
+    if (!reader.beginObject())
+    {
+        reader.skipValue();
+        return value;
+    }
+    while (reader.nextKey(key))
+    {
+        if (key == member)
+        {
+            reader.readScalar(value);
+        }
+        else
+        {
+            reader.skipValue();
+        }
+    }
+    return value;
+}
+
+// Read an array of {"description": ...} objects such as genres and categories
+static void readDescriptions(JsonReader &reader, std::vector<std::string> &out)
+{
+    if (!reader.beginArray())
+    {
+        reader.skipValue();
+        return;
+    }
+    while (reader.nextElement())
+    {
+        std::string description = readMember(reader, "description");
+        if (!description.empty())
+        {
+            out.push_back(std::move(description));
+        }
+    }
+}
+
+// Read a price_overview object
+static void readPriceOverview(JsonReader &reader, std::string &finalPrice, std::string &initialPrice,
+                              std::string &discountPercent, std::string &currency)
+{
+    std::string_view key;
+    if (!reader.beginObject())
+    {
+        reader.skipValue();
+        return;
+    }
+    while (reader.nextKey(key))
+    {
+        if (key == "final_formatted")
+            reader.readScalar(finalPrice);
+        else if (key == "initial_formatted")
+            reader.readScalar(initialPrice);
+        else if (key == "discount_percent")
+            reader.readScalar(discountPercent);
+        else if (key == "currency")
+            reader.readScalar(currency);
+        else
+            reader.skipValue();
+    }
+}
+
+// Map the local app catalog once, downloading it on first use
+static CatalogIndex &loadCatalog()
+{
+    static std::once_flag loaded;
+    CatalogIndex &catalog = CatalogIndex::getInstance();
+    std::call_once(loaded, [&catalog]()
+                   {
+        Config &config = Config::getInstance();
+        std::string path = config.get("CATALOG_FILE");
+        int maxAgeHours = 168;
+        try
+        {
+            std::string hours = config.get("CATALOG_EXPIRY_HOURS");
+            if (!hours.empty())
+            {
+                maxAgeHours = std::stoi(hours);
+            }
+        }
+        catch (const std::exception &)
+        {
+        }
+        if (!catalog.load(path.empty() ? "steam_catalog.bin" : path, maxAgeHours))
+        {
+            std::cerr << "Warning: Steam app catalog unavailable, searching popular titles only." << std::endl;
+        } });
+    return catalog;
+}
+
+// Sections each lookup needs from appdetails
+static const unsigned GAME_INFO_FIELDS = APP_FIELD_BASIC | APP_FIELD_PRICE_OVERVIEW | APP_FIELD_DEVELOPERS |
+                                         APP_FIELD_PUBLISHERS | APP_FIELD_RELEASE_DATE | APP_FIELD_METACRITIC |
+                                         APP_FIELD_RECOMMENDATIONS | APP_FIELD_GENRES | APP_FIELD_CATEGORIES;
+static const unsigned SALE_INFO_FIELDS = APP_FIELD_BASIC | APP_FIELD_PRICE_OVERVIEW;
+static const unsigned PRICE_FIELDS = APP_FIELD_PRICE_OVERVIEW;
+
+// Normalize the price fields of a sale record once its appdetails data has been read
+static void finishSaleInfo(SteamSaleInfo &saleInfo, bool hasPriceOverview, bool isFree)
+{
+    if (saleInfo.currency.empty())
+    {
+        saleInfo.currency = "USD";
+    }
+
+    if (hasPriceOverview)
+    {
+        // Check if it's actually on sale
+        if (!saleInfo.discountPercent.empty() && saleInfo.discountPercent != "0")
+        {
+            // It's on sale, keep the discount info
+            saleInfo.isHighlighted = (std::stoi(saleInfo.discountPercent) >= 25);
+        }
+        else
+        {
+            // Not on sale, use current price as the main price
+            if (saleInfo.originalPrice.empty())
+            {
+                saleInfo.originalPrice = saleInfo.currentPrice;
+            }
+            saleInfo.discountPercent = "";
+        }
+    }
+    else if (isFree)
+    {
+        saleInfo.currentPrice = "Free to Play";
+        saleInfo.originalPrice = "Free to Play";
+    }
+}
+
+// Read a multi-app appdetails response filtered to price_overview:
+// {"<appid>": {"success": true, "data": {"price_overview": {...}}}, ...}
+// Apps without a price (free, unreleased) come back with "data": [] and are left unpriced.
+static void readPriceBatch(const std::string &response, const std::unordered_map<std::string, size_t> &positions,
+                           std::vector<SteamSaleInfo> &sales, std::vector<bool> &priced)
+{
+    TRACE_SCOPE("readPriceBatch", "parse");
+    JsonReader reader(response);
+    std::string_view key;
+    if (!reader.beginObject())
+    {
+        return;
+    }
+    while (reader.nextKey(key))
+    {
+        auto position = positions.find(std::string(key));
+        if (position == positions.end() || !reader.beginObject())
+        {
+            reader.skipValue();
+            continue;
+        }
+        SteamSaleInfo &saleInfo = sales[position->second];
+        while (reader.nextKey(key))
+        {
+            if (key != "data" || !reader.beginObject())
+            {
+                reader.skipValue();
+                continue;
+            }
+            while (reader.nextKey(key))
+            {
+                if (key == "price_overview")
+                {
+                    readPriceOverview(reader, saleInfo.currentPrice, saleInfo.originalPrice, saleInfo.discountPercent, saleInfo.currency);
+                    priced[position->second] = true;
+                }
+                else
+                {
+                    reader.skipValue();
+                }
+            }
+        }
+    }
+}
+
+// Popular titles and abbreviations (cs2, tf2, ...) the catalog cannot resolve by name;
+// checked before the full catalog and also fed to the fuzzy index
+static const std::map<std::string, std::string> popularGames = {
+    {"god of war", "1593500"},
+    {"cyberpunk 2077", "1091500"},
+    {"cyberpunk", "1091500"},
+    {"dota 2", "570"},
+    {"dota", "570"},
+    {"counter-strike 2", "730"},
+    {"cs2", "730"},
+    {"counter-strike", "730"},
+    {"team fortress 2", "440"},
+    {"tf2", "440"},
+    {"half-life 2", "220"},
+    {"portal", "400"},
+    {"portal 2", "620"},
+    {"left 4 dead 2", "550"},
+    {"gta v", "271590"},
+    {"grand theft auto v", "271590"},
+    {"the witcher 3", "292030"},
+    {"witcher 3", "292030"},
+    {"skyrim", "72850"},
+    {"elder scrolls v", "72850"},
+    {"fallout 4", "377160"},
+    {"minecraft", "1238430"},
+    {"terraria", "105600"},
+    {"among us", "945360"},
+    {"valheim", "892970"},
+    {"stardew valley", "413150"},
+    {"pubg", "578080"},
+    {"apex legends", "1172470"},
+    {"destiny 2", "1085660"},
+    {"warframe", "230410"},
+    {"rocket league", "252950"},
+    {"rust", "252490"},
+    {"ark", "346110"},
+    {"subnautica", "264710"},
+    {"hollow knight", "367520"},
+    {"dark souls 3", "374320"},
+    {"elden ring", "1245620"},
+    {"red dead redemption 2", "1174180"},
+    {"hades", "1145360"},
+    {"disco elysium", "632470"},
+    {"ori and the blind forest", "261570"},
+    {"celeste", "504230"},
+    {"factorio", "427520"},
+    {"rimworld", "294100"},
+    {"cities skylines", "255710"},
+    {"civilization vi", "289070"},
+    {"total war", "364360"},
+    {"football manager", "1569040"},
+    {"fifa", "1313860"},
+    {"call of duty", "1938090"},
+    {"battlefield", "1517290"},
+    {"assassin's creed", "1368820"},
+    {"far cry", "552520"},
+    {"watch dogs", "1208080"},
+    {"borderlands 3", "397540"},
+    {"monster hunter", "1334050"},
+    {"resident evil", "1196590"},
+    {"devil may cry", "601150"},
+    {"final fantasy", "1313600"},
+    {"tomb raider", "750920"},
+    {"hitman", "1659040"},
+    {"metro exodus", "412020"},
+    {"control", "870780"},
+    {"death stranding", "1190460"},
+    {"no man's sky", "275850"},
+    {"sea of thieves", "1172620"},
+    {"forza horizon", "1551360"},
+    {"microsoft flight simulator", "1250410"},
+    {"age of empires", "1466860"}};
+
+// Build the trigram index over the catalog and the popular titles once
+static const FuzzyIndex &loadFuzzyIndex()
+{
+    static FuzzyIndex index;
+    static std::once_flag built;
+    std::call_once(built, []()
+                   {
+        const CatalogIndex &catalog = loadCatalog();
+        for (size_t i = 0; i < catalog.size(); ++i)
+        {
+            CatalogIndex::App app = catalog.at(i);
+            index.add(app.appId, app.name);
+        }
+        for (const auto &game : popularGames)
+        {
+            index.add(static_cast<uint32_t>(std::stoul(game.second)), game.first);
+        }
+        index.build(); });
+    return index;
+}
 
 bool SteamApiHelper::initialize()
 {
@@ -31,10 +365,7 @@ bool SteamApiHelper::initialize()
         return false;
     }
 
-    lastApiCall = 0;
-    callsInLastMinute = 0;
-
-    std::cout << "Steam API initialized successfully." << std::endl;
+    std::cerr << "Steam API initialized successfully." << std::endl;
     return true;
 }
 
@@ -43,40 +374,20 @@ SteamGameInfo SteamApiHelper::getGameInfo(const std::string &appId)
     SteamGameInfo gameInfo;
     gameInfo.appId = appId;
 
+    PersistentCache &cache = PersistentCache::getInstance();
+    if (cache.loadGameInfo(appId, gameInfo))
+    {
+        return gameInfo;
+    }
+
     try
     {
         // Get basic app details from Steam Store API
-        std::string storeParams = "appids=" + appId + "&cc=US&l=en";
-        std::string storeResponse = makeApiCall("/appdetails", storeParams);
-
-        // Parse the response (basic parsing - in a real implementation, you'd use a JSON library)
-        gameInfo.name = parseJsonValue(storeResponse, "name");
-        gameInfo.description = parseJsonValue(storeResponse, "short_description");
-        gameInfo.developer = parseJsonValue(storeResponse, "developers");
-        gameInfo.publisher = parseJsonValue(storeResponse, "publishers");
-        gameInfo.releaseDate = parseJsonValue(storeResponse, "release_date");
-        gameInfo.headerImage = parseJsonValue(storeResponse, "header_image");
-        gameInfo.metacriticScore = parseJsonValue(storeResponse, "metacritic");
-
-        // Check if the game is free
-        std::string isFreeStr = parseJsonValue(storeResponse, "is_free");
-        gameInfo.isFree = (isFreeStr == "true");
-
-        if (!gameInfo.isFree)
-        {
-            std::string priceOverview = parseJsonValue(storeResponse, "price_overview");
-            gameInfo.price = parseJsonValue(priceOverview, "final_formatted");
-            gameInfo.originalPrice = parseJsonValue(priceOverview, "initial_formatted");
-            gameInfo.discountPercent = parseJsonValue(priceOverview, "discount_percent");
-            gameInfo.currency = parseJsonValue(priceOverview, "currency");
-
-            // Check if on sale
-            std::string discountPercent = parseJsonValue(priceOverview, "discount_percent");
-            gameInfo.isOnSale = (!discountPercent.empty() && discountPercent != "0");
-        }
-        else
+        std::string storeResponse = makeApiCall("/appdetails", appDetailsParams(appId, GAME_INFO_FIELDS));
+        gameInfo = parseGameInfo(appId, storeResponse);
+        if (!gameInfo.name.empty())
         {
-            gameInfo.isOnSale = false;
+            cache.storeGameInfo(gameInfo);
         }
     }
     catch (const std::exception &e)
@@ -87,85 +398,65 @@ SteamGameInfo SteamApiHelper::getGameInfo(const std::string &appId)
     return gameInfo;
 }
 
+SteamGameInfo SteamApiHelper::parseGameInfo(const std::string &appId, const std::string &storeResponse)
+{
+    SteamGameInfo gameInfo;
+    gameInfo.appId = appId;
+    gameInfo.isFree = false;
+    gameInfo.isOnSale = false;
+    TRACE_SCOPE("parseGameInfo", "parse", appId);
+
+    // Walk the app's data object once, filling fields as their keys go by
+    JsonReader reader(storeResponse);
+    if (!findAppData(reader, appId))
+    {
+        return gameInfo;
+    }
+
+    std::string_view key;
+    reader.beginObject();
+    while (reader.nextKey(key))
+    {
+        if (key == "name")
+            reader.readScalar(gameInfo.name);
+        else if (key == "short_description")
+            reader.readScalar(gameInfo.description);
+        else if (key == "developers")
+            gameInfo.developer = readJoinedStrings(reader);
+        else if (key == "publishers")
+            gameInfo.publisher = readJoinedStrings(reader);
+        else if (key == "release_date")
+            gameInfo.releaseDate = readMember(reader, "date");
+        else if (key == "header_image")
+            reader.readScalar(gameInfo.headerImage);
+        else if (key == "metacritic")
+            gameInfo.metacriticScore = readMember(reader, "score");
+        else if (key == "recommendations")
+            gameInfo.userReviews = readMember(reader, "total");
+        else if (key == "is_free")
+            gameInfo.isFree = reader.readBool();
+        else if (key == "price_overview")
+            readPriceOverview(reader, gameInfo.price, gameInfo.originalPrice, gameInfo.discountPercent, gameInfo.currency);
+        else if (key == "genres")
+            readDescriptions(reader, gameInfo.genres);
+        else if (key == "categories")
+            readDescriptions(reader, gameInfo.categories);
+        else
+            reader.skipValue();
+    }
+
+    // Check if on sale
+    gameInfo.isOnSale = !gameInfo.isFree && !gameInfo.discountPercent.empty() && gameInfo.discountPercent != "0";
+
+    return gameInfo;
+}
+
 std::vector<SteamGameInfo> SteamApiHelper::searchGames(const std::string &searchTerm)
 {
     std::vector<SteamGameInfo> results;
 
     try
     {
-        // Create a map of popular games for quick lookup
-        // In a full implementation, you'd want to cache the full Steam app list
-        std::map<std::string, std::string> popularGames = {
-            {"god of war", "1593500"},
-            {"cyberpunk 2077", "1091500"},
-            {"cyberpunk", "1091500"},
-            {"dota 2", "570"},
-            {"dota", "570"},
-            {"counter-strike 2", "730"},
-            {"cs2", "730"},
-            {"counter-strike", "730"},
-            {"team fortress 2", "440"},
-            {"tf2", "440"},
-            {"half-life 2", "220"},
-            {"portal", "400"},
-            {"portal 2", "620"},
-            {"left 4 dead 2", "550"},
-            {"gta v", "271590"},
-            {"grand theft auto v", "271590"},
-            {"the witcher 3", "292030"},
-            {"witcher 3", "292030"},
-            {"skyrim", "72850"},
-            {"elder scrolls v", "72850"},
-            {"fallout 4", "377160"},
-            {"minecraft", "1238430"},
-            {"terraria", "105600"},
-            {"among us", "945360"},
-            {"valheim", "892970"},
-            {"stardew valley", "413150"},
-            {"pubg", "578080"},
-            {"apex legends", "1172470"},
-            {"destiny 2", "1085660"},
-            {"warframe", "230410"},
-            {"rocket league", "252950"},
-            {"rust", "252490"},
-            {"ark", "346110"},
-            {"subnautica", "264710"},
-            {"hollow knight", "367520"},
-            {"dark souls 3", "374320"},
-            {"elden ring", "1245620"},
-            {"red dead redemption 2", "1174180"},
-            {"hades", "1145360"},
-            {"disco elysium", "632470"},
-            {"ori and the blind forest", "261570"},
-            {"celeste", "504230"},
-            {"factorio", "427520"},
-            {"rimworld", "294100"},
-            {"cities skylines", "255710"},
-            {"civilization vi", "289070"},
-            {"total war", "364360"},
-            {"football manager", "1569040"},
-            {"fifa", "1313860"},
-            {"call of duty", "1938090"},
-            {"battlefield", "1517290"},
-            {"assassin's creed", "1368820"},
-            {"far cry", "552520"},
-            {"watch dogs", "1208080"},
-            {"borderlands 3", "397540"},
-            {"monster hunter", "1334050"},
-            {"resident evil", "1196590"},
-            {"devil may cry", "601150"},
-            {"final fantasy", "1313600"},
-            {"tomb raider", "750920"},
-            {"hitman", "1659040"},
-            {"metro exodus", "412020"},
-            {"control", "870780"},
-            {"death stranding", "1190460"},
-            {"no man's sky", "275850"},
-            {"sea of thieves", "1172620"},
-            {"forza horizon", "1551360"},
-            {"microsoft flight simulator", "1250410"},
-            {"age of empires", "1466860"}};
-
         // Convert search term to lowercase for matching
         std::string lowerSearchTerm = searchTerm;
         std::transform(lowerSearchTerm.begin(), lowerSearchTerm.end(), lowerSearchTerm.begin(), ::tolower);
@@ -182,32 +473,66 @@ std::vector<SteamGameInfo> SteamApiHelper::searchGames(const std::string &search
             }
         }
 
-        // Look for partial matches
+        // Collect up to 5 candidates to avoid overwhelming the user
+        std::vector<std::string> candidateAppIds;
         std::set<std::string> addedAppIds; // Track added games to avoid duplicates
-        for (const auto &game : popularGames)
+        auto addCandidate = [&](const std::string &appId)
+        {
+            if (candidateAppIds.size() < 5 && addedAppIds.insert(appId).second)
+            {
+                candidateAppIds.push_back(appId);
+            }
+        };
+
+        // Exact title matches from the local app catalog
+        CatalogIndex &catalog = loadCatalog();
+        for (const auto &app : catalog.findExact(searchTerm, 5))
+        {
+            addCandidate(std::to_string(app.appId));
+        }
+
+        if (candidateAppIds.empty())
+        {
+            // Typo-tolerant ranked matches ("witcher3", "cyberpnk"); over-fetch since
+            // aliases and catalog entries can point at the same app
+            for (const auto &match : loadFuzzyIndex().search(searchTerm, 15))
+            {
+                addCandidate(std::to_string(match.appId));
+            }
+        }
+
+        // Fetch all uncached candidates concurrently, then collect them in match order
+        PersistentCache &cache = PersistentCache::getInstance();
+        std::vector<SteamGameInfo> cached(candidateAppIds.size());
+        std::vector<std::future<std::string>> responses(candidateAppIds.size());
+        for (size_t i = 0; i < candidateAppIds.size(); ++i)
         {
-            if (game.first.find(lowerSearchTerm) != std::string::npos ||
-                lowerSearchTerm.find(game.first) != std::string::npos)
+            if (!cache.loadGameInfo(candidateAppIds[i], cached[i]))
             {
+                responses[i] = makeApiCallAsync("/appdetails", appDetailsParams(candidateAppIds[i], GAME_INFO_FIELDS));
+            }
+        }
 
-                // Skip if we already added this App ID
-                if (addedAppIds.find(game.second) != addedAppIds.end())
+        for (size_t i = 0; i < candidateAppIds.size(); ++i)
+        {
+            try
+            {
+                if (!responses[i].valid())
                 {
+                    results.push_back(cached[i]);
                     continue;
                 }
-
-                SteamGameInfo gameInfo = getGameInfo(game.second);
+                SteamGameInfo gameInfo = parseGameInfo(candidateAppIds[i], responses[i].get());
                 if (!gameInfo.name.empty())
                 {
+                    cache.storeGameInfo(gameInfo);
                     results.push_back(gameInfo);
-                    addedAppIds.insert(game.second);
-                    // Limit to top 5 results to avoid overwhelming the user
-                    if (results.size() >= 5)
-                    {
-                        break;
-                    }
                 }
             }
+            catch (const std::exception &e)
+            {
+                std::cerr << "Error fetching game info for app ID " << candidateAppIds[i] << ": " << e.what() << std::endl;
+            }
         }
     }
     catch (const std::exception &e)
@@ -222,10 +547,10 @@ std::string SteamApiHelper::getGamePrice(const std::string &appId, const std::st
 {
     try
     {
-        std::string params = "appids=" + appId + "&cc=" + countryCode;
-        std::string response = makeApiCall("/appdetails", params);
+        // Free and unreleased apps have no price_overview and yield an empty price
+        std::string response = makeApiCall("/appdetails", appDetailsParams(appId, PRICE_FIELDS, countryCode));
 
-        return parseJsonValue(response, "price_overview");
+        return parseSaleInfo(appId, response).currentPrice;
     }
     catch (const std::exception &e)
     {
@@ -238,15 +563,62 @@ SteamPlayerInfo SteamApiHelper::getPlayerInfo(const std::string &steamId)
 {
     SteamPlayerInfo playerInfo;
     playerInfo.steamId = steamId;
+    playerInfo.communityVisibilityState = 0;
+    playerInfo.profileState = 0;
+    playerInfo.lastLogoff = 0;
 
     try
     {
         std::string params = "steamids=" + steamId + "&format=json";
         std::string response = makeApiCall("/ISteamUser/GetPlayerSummaries/v2/", params);
 
-        playerInfo.personaName = parseJsonValue(response, "personaname");
-        playerInfo.profileUrl = parseJsonValue(response, "profileurl");
-        playerInfo.avatar = parseJsonValue(response, "avatarfull");
+        // Layout: {"response": {"players": [{...}]}}
+        JsonReader reader(response);
+        std::string_view key;
+        if (reader.beginObject())
+        {
+            while (reader.nextKey(key))
+            {
+                if (key != "response" || !reader.beginObject())
+                {
+                    reader.skipValue();
+                    continue;
+                }
+                while (reader.nextKey(key))
+                {
+                    if (key != "players" || !reader.beginArray())
+                    {
+                        reader.skipValue();
+                        continue;
+                    }
+                    while (reader.nextElement())
+                    {
+                        if (!reader.beginObject())
+                        {
+                            reader.skipValue();
+                            continue;
+                        }
+                        while (reader.nextKey(key))
+                        {
+                            if (key == "personaname")
+                                reader.readScalar(playerInfo.personaName);
+                            else if (key == "profileurl")
+                                reader.readScalar(playerInfo.profileUrl);
+                            else if (key == "avatarfull")
+                                reader.readScalar(playerInfo.avatar);
+                            else if (key == "communityvisibilitystate")
+                                playerInfo.communityVisibilityState = static_cast<int>(reader.readInteger());
+                            else if (key == "profilestate")
+                                playerInfo.profileState = static_cast<int>(reader.readInteger());
+                            else if (key == "lastlogoff")
+                                playerInfo.lastLogoff = static_cast<long>(reader.readInteger());
+                            else
+                                reader.skipValue();
+                        }
+                    }
+                }
+            }
+        }
     }
     catch (const std::exception &e)
     {
@@ -283,7 +655,21 @@ std::string SteamApiHelper::resolveVanityUrl(const std::string &vanityUrl)
         std::string params = "vanityurl=" + vanityUrl + "&url_type=1&format=json";
         std::string response = makeApiCall("/ISteamUser/ResolveVanityURL/v1/", params);
 
-        return parseJsonValue(response, "steamid");
+        // Layout: {"response": {"steamid": "...", "success": 1}}
+        JsonReader reader(response);
+        std::string_view key;
+        if (reader.beginObject())
+        {
+            while (reader.nextKey(key))
+            {
+                if (key == "response")
+                {
+                    return readMember(reader, "steamid");
+                }
+                reader.skipValue();
+            }
+        }
+        return "";
     }
     catch (const std::exception &e)
     {
@@ -311,124 +697,96 @@ bool SteamApiHelper::isValidSteamId(const std::string &steamId)
     return true;
 }
 
-void SteamApiHelper::respectRateLimit()
+std::string SteamApiHelper::makeApiCall(const std::string &endpoint, const std::string &params)
 {
-    updateRateLimit();
-
-    Config &config = Config::getInstance();
-    int maxCallsPerMinute = std::stoi(config.get("API_RATE_LIMIT_PER_MINUTE"));
-
-    if (callsInLastMinute >= maxCallsPerMinute)
+    // For store API calls, use store API base URL
+    if (endpoint.find("/appdetails") != std::string::npos)
     {
-        std::cout << "Rate limit reached, waiting..." << std::endl;
-        std::this_thread::sleep_for(std::chrono::minutes(1));
-        updateRateLimit();
+        return NetworkUtils::fetchPageWithRetry(buildApiUrl(endpoint, params));
     }
 
-    // Minimum delay between calls
-    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
-                   std::chrono::system_clock::now().time_since_epoch())
-                   .count();
-
-    if (now - lastApiCall < 100)
-    { // 100ms minimum between calls
-        std::this_thread::sleep_for(std::chrono::milliseconds(100 - (now - lastApiCall)));
-    }
+    // For regular Steam Web API calls
+    std::string additionalParams = params.empty() ? "format=json" : params + "&format=json";
+    return NetworkUtils::fetchSteamApiData(endpoint, additionalParams);
 }
 
-std::string SteamApiHelper::makeApiCall(const std::string &endpoint, const std::string &params)
+std::future<std::string> SteamApiHelper::makeApiCallAsync(const std::string &endpoint, const std::string &params)
 {
-    respectRateLimit();
+    return NetworkUtils::fetchPageAsync(buildApiUrl(endpoint, params));
+}
 
+std::string SteamApiHelper::buildApiUrl(const std::string &endpoint, const std::string &params)
+{
     Config &config = Config::getInstance();
-    std::string baseUrl = config.get("STEAM_API_BASE_URL");
-    if (baseUrl.empty())
-    {
-        baseUrl = "https://api.steampowered.com";
-    }
 
     // For store API calls, use store API base URL
     if (endpoint.find("/appdetails") != std::string::npos)
     {
-        baseUrl = config.get("STEAM_STORE_API_BASE_URL");
+        std::string baseUrl = config.get("STEAM_STORE_API_BASE_URL");
         if (baseUrl.empty())
         {
             baseUrl = "https://store.steampowered.com/api";
         }
-        return NetworkUtils::fetchPageWithRetry(baseUrl + endpoint + "?" + params);
+        return baseUrl + endpoint + "?" + params;
     }
 
     // For regular Steam Web API calls
     std::string additionalParams = params.empty() ? "format=json" : params + "&format=json";
-    return NetworkUtils::fetchSteamApiData(endpoint, additionalParams);
-}
-
-void SteamApiHelper::updateRateLimit()
-{
-    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
-                   std::chrono::system_clock::now().time_since_epoch())
-                   .count();
-
-    // Remove calls older than 1 minute
-    recentCalls.erase(
-        std::remove_if(recentCalls.begin(), recentCalls.end(),
-                       [now](long callTime)
-                       { return (now - callTime) > 60000; }),
-        recentCalls.end());
-
-    callsInLastMinute = recentCalls.size();
-    lastApiCall = now;
-    recentCalls.push_back(now);
+    return NetworkUtils::buildSteamApiUrl(endpoint, additionalParams);
 }
 
-std::string SteamApiHelper::parseJsonValue(const std::string &json, const std::string &key)
+std::string SteamApiHelper::appDetailsParams(const std::string &appIds, unsigned fields, const std::string &countryCode)
 {
-    // Very basic JSON value extraction - in a real implementation, use a proper JSON library
-    std::string searchKey = "\"" + key + "\"";
-    size_t pos = json.find(searchKey);
-
-    if (pos == std::string::npos)
+    static const std::pair<unsigned, const char *> FILTER_NAMES[] = {
+        {APP_FIELD_BASIC, "basic"},
+        {APP_FIELD_PRICE_OVERVIEW, "price_overview"},
+        {APP_FIELD_DEVELOPERS, "developers"},
+        {APP_FIELD_PUBLISHERS, "publishers"},
+        {APP_FIELD_RELEASE_DATE, "release_date"},
+        {APP_FIELD_METACRITIC, "metacritic"},
+        {APP_FIELD_RECOMMENDATIONS, "recommendations"},
+        {APP_FIELD_GENRES, "genres"},
+        {APP_FIELD_CATEGORIES, "categories"}};
+
+    std::string filters;
+    for (const auto &filter : FILTER_NAMES)
     {
-        return "";
+        if (fields & filter.first)
+        {
+            filters += (filters.empty() ? "" : ",") + std::string(filter.second);
+        }
     }
-
-    pos += searchKey.length();
-    pos = json.find(":", pos);
-    if (pos == std::string::npos)
+    std::string params = "appids=" + appIds + "&cc=" + countryCode + "&l=en";
+    if (!filters.empty())
     {
-        return "";
+        params += "&filters=" + filters;
     }
+    return params;
+}
 
-    pos++;
-    while (pos < json.length() && std::isspace(json[pos]))
+std::string SteamApiHelper::findAppId(const std::string &nameOrAppId)
+{
+    if (!nameOrAppId.empty() && std::all_of(nameOrAppId.begin(), nameOrAppId.end(), [](unsigned char c)
+                                            { return std::isdigit(c) != 0; }))
     {
-        pos++;
+        return nameOrAppId;
     }
 
-    if (pos >= json.length())
+    std::string lowerName = nameOrAppId;
+    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+    auto alias = popularGames.find(lowerName);
+    if (alias != popularGames.end())
     {
-        return "";
+        return alias->second;
     }
 
-    if (json[pos] == '"')
+    std::vector<CatalogIndex::App> exact = loadCatalog().findExact(nameOrAppId, 1);
+    if (!exact.empty())
     {
-        pos++;
-        size_t endPos = json.find('"', pos);
-        if (endPos != std::string::npos)
-        {
-            return json.substr(pos, endPos - pos);
-        }
+        return std::to_string(exact.front().appId);
     }
-    else
-    {
-        size_t endPos = json.find_first_of(",}\n", pos);
-        if (endPos != std::string::npos)
-        {
-            return json.substr(pos, endPos - pos);
-        }
-    }
-
-    return "";
+    std::vector<FuzzyIndex::Match> fuzzy = loadFuzzyIndex().search(nameOrAppId, 1);
+    return fuzzy.empty() ? "" : std::to_string(fuzzy.front().appId);
 }
 
 // Sales and pricing methods implementation
@@ -452,25 +810,21 @@ std::vector<SteamSaleInfo> SteamApiHelper::getCurrentSales(int limit)
             "346110"   // ARK: Survival Evolved
         };
 
-        for (const auto &appId : popularAppIds)
+        // One batched price request covers the whole list
+        for (SteamSaleInfo &saleInfo : getSaleInfoBatch(popularAppIds))
         {
-            if (sales.size() >= limit)
+            if (sales.size() >= static_cast<size_t>(limit))
                 break;
 
-            try
+            // Add to sales list regardless of whether it's on sale or not
+            // This will show current pricing for popular games
+            if (!saleInfo.name.empty())
             {
-                SteamSaleInfo saleInfo = getSaleInfo(appId);
-                if (!saleInfo.name.empty())
-                {
-                    // Add to sales list regardless of whether it's on sale or not
-                    // This will show current pricing for popular games
-                    sales.push_back(saleInfo);
-                }
+                sales.push_back(std::move(saleInfo));
             }
-            catch (const std::exception &e)
+            else if (!saleInfo.error.empty())
             {
-                // Continue with next game if one fails
-                continue;
+                std::cerr << "Error fetching sale info for app ID " << saleInfo.appId << ": " << saleInfo.error << std::endl;
             }
         }
     }
@@ -496,13 +850,10 @@ bool SteamApiHelper::isGameOnSale(const std::string &appId)
 {
     try
     {
-        std::string params = "appids=" + appId + "&cc=US&l=en";
-        std::string response = makeApiCall("/appdetails", params);
-
-        std::string priceOverview = parseJsonValue(response, "price_overview");
-        std::string discountPercent = parseJsonValue(priceOverview, "discount_percent");
+        std::string response = makeApiCall("/appdetails", appDetailsParams(appId, PRICE_FIELDS));
 
-        return (!discountPercent.empty() && discountPercent != "0");
+        // parseSaleInfo clears the discount when the game is not on sale
+        return !parseSaleInfo(appId, response).discountPercent.empty();
     }
     catch (const std::exception &e)
     {
@@ -510,71 +861,182 @@ bool SteamApiHelper::isGameOnSale(const std::string &appId)
     }
 }
 
-SteamSaleInfo SteamApiHelper::getSaleInfo(const std::string &appId)
+SteamSaleInfo SteamApiHelper::getSaleInfo(const std::string &appId, const std::string &countryCode)
 {
     SteamSaleInfo saleInfo;
     saleInfo.appId = appId;
 
-    try
+    PersistentCache &cache = PersistentCache::getInstance();
+    if (cache.loadSaleInfo(appId, saleInfo, countryCode))
     {
-        std::string params = "appids=" + appId + "&cc=US&l=en";
-        std::string response = makeApiCall("/appdetails", params);
+        return saleInfo;
+    }
 
-        // Parse the JSON response more carefully
-        // Find the data section for this appId
-        std::string dataKey = "\"" + appId + "\"";
-        size_t dataPos = response.find(dataKey);
-        if (dataPos == std::string::npos)
+    try
+    {
+        // Like the batch path, take the name from the catalog and ask only for the price;
+        // "basic" is needed when the catalog lacks the app or no price came back (free or unpriced)
+        std::string_view name = loadCatalog().findName(static_cast<uint32_t>(std::strtoul(appId.c_str(), nullptr, 10)));
+        if (!name.empty())
         {
-            return saleInfo; // Return empty if not found
+            saleInfo = parseSaleInfo(appId, makeApiCall("/appdetails", appDetailsParams(appId, PRICE_FIELDS, countryCode)));
+            saleInfo.name = std::string(name);
         }
+        if (name.empty() || saleInfo.currentPrice.empty())
+        {
+            saleInfo = parseSaleInfo(appId, makeApiCall("/appdetails", appDetailsParams(appId, SALE_INFO_FIELDS, countryCode)));
+        }
+        if (!saleInfo.name.empty())
+        {
+            cache.storeSaleInfo(saleInfo, countryCode);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error fetching sale info for app ID " << appId << ": " << e.what() << std::endl;
+    }
 
-        // Extract basic game info
-        saleInfo.name = parseJsonValue(response, "name");
-        saleInfo.headerImage = parseJsonValue(response, "header_image");
-        saleInfo.currency = "USD";
+    return saleInfo;
+}
+
+std::vector<SteamSaleInfo> SteamApiHelper::getSaleInfoBatch(const std::vector<std::string> &appIds, const std::string &countryCode)
+{
+    std::vector<SteamSaleInfo> sales(appIds.size());
+    std::vector<bool> priced(appIds.size(), false);
+    std::unordered_map<std::string, size_t> positions;
+    std::vector<std::string> uncached;
 
-        // Look for price_overview section
-        std::string priceOverview = parseJsonValue(response, "price_overview");
-        if (!priceOverview.empty())
+    PersistentCache &cache = PersistentCache::getInstance();
+    for (size_t i = 0; i < appIds.size(); ++i)
+    {
+        sales[i].appId = appIds[i];
+        sales[i].isHighlighted = false;
+        bool first = positions.emplace(appIds[i], i).second;
+        if (first && !cache.loadSaleInfo(appIds[i], sales[i], countryCode))
         {
-            saleInfo.currentPrice = parseJsonValue(priceOverview, "final_formatted");
-            saleInfo.originalPrice = parseJsonValue(priceOverview, "initial_formatted");
-            saleInfo.discountPercent = parseJsonValue(priceOverview, "discount_percent");
+            uncached.push_back(appIds[i]);
+        }
+    }
 
-            // Check if it's actually on sale
-            if (!saleInfo.discountPercent.empty() && saleInfo.discountPercent != "0")
+    // Issue every chunk up front so the transfers overlap
+    std::vector<std::pair<size_t, std::future<std::string>>> responses;
+    for (size_t start = 0; start < uncached.size(); start += APPDETAILS_BATCH_SIZE)
+    {
+        std::string ids;
+        for (size_t i = start; i < std::min(uncached.size(), start + APPDETAILS_BATCH_SIZE); ++i)
+        {
+            ids += (ids.empty() ? "" : ",") + uncached[i];
+        }
+        responses.emplace_back(start, makeApiCallAsync("/appdetails", appDetailsParams(ids, PRICE_FIELDS, countryCode)));
+    }
+    for (auto &response : responses)
+    {
+        try
+        {
+            readPriceBatch(response.second.get(), positions, sales, priced);
+        }
+        catch (const std::exception &e)
+        {
+            // Every app in a failed chunk fails; retrying each one alone would only hammer the host
+            for (size_t i = response.first; i < std::min(uncached.size(), response.first + APPDETAILS_BATCH_SIZE); ++i)
             {
-                // It's on sale, keep the discount info
-                saleInfo.isHighlighted = (std::stoi(saleInfo.discountPercent) >= 25);
-            }
-            else
-            {
-                // Not on sale, use current price as the main price
-                if (saleInfo.originalPrice.empty())
-                {
-                    saleInfo.originalPrice = saleInfo.currentPrice;
-                }
-                saleInfo.discountPercent = "";
-                saleInfo.isHighlighted = false;
+                sales[positions[uncached[i]]].error = e.what();
             }
         }
+    }
+
+    // price_overview responses carry no names, so take them from the local catalog;
+    // apps it cannot fully describe (unknown name, free or unpriced) get a full request,
+    // all issued before any is read so they overlap
+    CatalogIndex &catalog = loadCatalog();
+    std::vector<std::pair<size_t, std::future<std::string>>> fallbacks;
+    for (const std::string &appId : uncached)
+    {
+        size_t position = positions[appId];
+        if (!sales[position].error.empty())
+        {
+            continue;
+        }
+        std::string_view name = catalog.findName(static_cast<uint32_t>(std::strtoul(appId.c_str(), nullptr, 10)));
+        if (priced[position] && !name.empty())
+        {
+            sales[position].name = std::string(name);
+            finishSaleInfo(sales[position], true, false);
+            cache.storeSaleInfo(sales[position], countryCode);
+        }
         else
         {
-            // Check if it's free to play
-            std::string isFree = parseJsonValue(response, "is_free");
-            if (isFree == "true")
+            fallbacks.emplace_back(position, makeApiCallAsync("/appdetails", appDetailsParams(appId, SALE_INFO_FIELDS, countryCode)));
+        }
+    }
+    for (auto &fallback : fallbacks)
+    {
+        std::string appId = sales[fallback.first].appId;
+        SteamSaleInfo saleInfo;
+        saleInfo.appId = appId;
+        saleInfo.isHighlighted = false;
+        try
+        {
+            saleInfo = parseSaleInfo(appId, fallback.second.get());
+            if (!saleInfo.name.empty())
             {
-                saleInfo.currentPrice = "Free to Play";
-                saleInfo.originalPrice = "Free to Play";
+                cache.storeSaleInfo(saleInfo, countryCode);
             }
-            saleInfo.isHighlighted = false;
         }
+        catch (const std::exception &e)
+        {
+            saleInfo.error = e.what();
+        }
+        sales[fallback.first] = saleInfo;
     }
-    catch (const std::exception &e)
+
+    // Repeated app IDs share the first occurrence's result
+    for (size_t i = 0; i < appIds.size(); ++i)
     {
-        std::cerr << "Error fetching sale info for app ID " << appId << ": " << e.what() << std::endl;
+        size_t position = positions[appIds[i]];
+        if (position != i)
+        {
+            sales[i] = sales[position];
+        }
+    }
+    return sales;
+}
+
+SteamSaleInfo SteamApiHelper::parseSaleInfo(const std::string &appId, const std::string &response)
+{
+    SteamSaleInfo saleInfo;
+    saleInfo.appId = appId;
+    saleInfo.isHighlighted = false;
+    TRACE_SCOPE("parseSaleInfo", "parse", appId);
+
+    // Find the data section for this appId
+    JsonReader reader(response);
+    if (!findAppData(reader, appId))
+    {
+        return saleInfo; // Return empty if not found
+    }
+
+    bool isFree = false;
+    bool hasPriceOverview = false;
+    std::string_view key;
+    reader.beginObject();
+    while (reader.nextKey(key))
+    {
+        if (key == "name")
+            reader.readScalar(saleInfo.name);
+        else if (key == "header_image")
+            reader.readScalar(saleInfo.headerImage);
+        else if (key == "is_free")
+            isFree = reader.readBool();
+        else if (key == "price_overview")
+        {
+            hasPriceOverview = true;
+            readPriceOverview(reader, saleInfo.currentPrice, saleInfo.originalPrice, saleInfo.discountPercent, saleInfo.currency);
+        }
+        else
+            reader.skipValue();
     }
 
+    finishSaleInfo(saleInfo, hasPriceOverview, isFree);
     return saleInfo;
 }
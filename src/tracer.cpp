@@ -0,0 +1,173 @@
+#include "tracer.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+// Append text as the contents of a JSON string
+static void appendEscaped(std::string &out, std::string_view text)
+{
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        }
+        else
+        {
+            out += c;
+        }
+    }
+}
+
+// Append nanoseconds as the fractional microseconds the trace format uses
+static void appendMicros(std::string &out, int64_t ns)
+{
+    char text[32];
+    ns = std::max<int64_t>(0, ns);
+    std::snprintf(text, sizeof(text), "%lld.%03lld", static_cast<long long>(ns / 1000), static_cast<long long>(ns % 1000));
+    out += text;
+}
+
+Tracer &Tracer::getInstance()
+{
+    static Tracer instance;
+    return instance;
+}
+
+void Tracer::start(const std::string &path)
+{
+    this->path = path;
+    origin = Clock::now();
+    active.store(true, std::memory_order_release);
+}
+
+Tracer::ThreadBuffer &Tracer::threadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> local;
+    if (!local)
+    {
+        local = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        local->tid = static_cast<uint32_t>(buffers.size() + 1);
+        buffers.push_back(local);
+    }
+    return *local;
+}
+
+void Tracer::record(const char *name, const char *category, char phase, uint64_t id, Clock::time_point start,
+                    Clock::time_point end, std::string_view detail)
+{
+    if (!active.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    ThreadBuffer &buffer = threadBuffer();
+    int64_t startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(start - origin).count();
+    int64_t durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back(Event{name, category, phase, id, startNs, durationNs, std::string(detail)});
+}
+
+void Tracer::complete(const char *name, const char *category, Clock::time_point start, Clock::time_point end,
+                      std::string_view detail)
+{
+    record(name, category, 'X', 0, start, end, detail);
+}
+
+void Tracer::async(const char *name, const char *category, uint64_t id, Clock::time_point start, Clock::time_point end,
+                   std::string_view detail)
+{
+    record(name, category, 'b', id, start, end, detail);
+}
+
+uint64_t Tracer::nextAsyncId()
+{
+    return asyncIds.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void Tracer::nameThread(const std::string &name)
+{
+    if (!enabled())
+    {
+        return;
+    }
+    ThreadBuffer &buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.name = name;
+}
+
+bool Tracer::write()
+{
+    active.store(false, std::memory_order_release);
+
+    std::string json = "{\"traceEvents\":[";
+    bool first = true;
+    auto begin = [&](const char *name, const char *category, const char *phase, uint32_t tid)
+    {
+        json += first ? "\n" : ",\n";
+        first = false;
+        json += "{\"name\":\"";
+        appendEscaped(json, name);
+        json += "\",\"cat\":\"";
+        appendEscaped(json, category);
+        json += "\",\"ph\":\"";
+        json += phase;
+        json += "\",\"pid\":1,\"tid\":" + std::to_string(tid);
+    };
+
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+    for (const auto &buffer : buffers)
+    {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        if (!buffer->name.empty())
+        {
+            begin("thread_name", "__metadata", "M", buffer->tid);
+            json += ",\"args\":{\"name\":\"";
+            appendEscaped(json, buffer->name);
+            json += "\"}}";
+        }
+        for (const Event &event : buffer->events)
+        {
+            std::string args;
+            if (!event.detail.empty())
+            {
+                args = ",\"args\":{\"detail\":\"";
+                appendEscaped(args, event.detail);
+                args += "\"}";
+            }
+            if (event.phase == 'X')
+            {
+                begin(event.name, event.category, "X", buffer->tid);
+                json += ",\"ts\":";
+                appendMicros(json, event.startNs);
+                json += ",\"dur\":";
+                appendMicros(json, event.durationNs);
+                json += args + "}";
+                continue;
+            }
+
+            // Async spans are a begin/end pair matched by category and id
+            std::string id = ",\"id\":\"" + std::to_string(event.id) + "\"";
+            begin(event.name, event.category, "b", buffer->tid);
+            json += id + ",\"ts\":";
+            appendMicros(json, event.startNs);
+            json += args + "}";
+            begin(event.name, event.category, "e", buffer->tid);
+            json += id + ",\"ts\":";
+            appendMicros(json, event.startNs + event.durationNs);
+            json += "}";
+        }
+    }
+    json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << json;
+    return static_cast<bool>(file);
+}